@@ -4,9 +4,14 @@
 #include <time.h>
 #include <ctype.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "cJSON.h"
 #include "minimax.h"
 #include "network.h"
+#include "mailbox.h"
+#include "anacache.h"
+#include "timeman.h"
+#include <pthread.h>
 
 #ifdef _WIN32
     #include <conio.h>
@@ -81,9 +86,11 @@
 #define BOARD_SIZE SIZE
 #define MAX_MOVES 60
 #define INFINITY_SCORE 10000000
+#define TURN_TIME_LIMIT 10  /* 한 턴 제한 시간 (초, 플레이어와 AI 공통) */
 
 /*==========전역 변수 상태=============*/
 int board[SIZE][SIZE];
+static unsigned char boardMailbox[MB_CELLS];  // board의 메일박스 사본 (승리 판정용)
 int cursorX = 0, cursorY = 0;
 int currentPlayer = BLACK;
 int gameMode = 0; /* 1=1인용, 2=2인용, 3=온라인 */
@@ -120,6 +127,30 @@ typedef enum {
 static int positionWeight[BOARD_SIZE][BOARD_SIZE];
 static int initialized = 0;
 
+// AI 턴 시계 (0이면 난이도별 시간 상한만, 켜면 반복 심화 시간 관리 + 하드 데드라인)
+// 탐색 중 상태(_Thread_local)는 스레드별: 힌트 스레드는 새로 시작할 때마다 0에서 출발하고
+// AI 탐색이 예산으로 끊겨 남긴 중단 플래그/노드 수를 물려받지 않음
+static int aiTurnTimeMs = 0;
+static _Thread_local int aiClockActive = 0;
+static _Thread_local int aiAborted = 0;
+static _Thread_local long long aiNodes = 0;
+static _Thread_local long long aiNodeLimit = 0;   // 0 = 제한 없음 (힌트 탐색)
+static TimeManager aiClock;
+
+// 힌트 탐색 (사람 차례에 백그라운드 스레드로 실행)
+#define HINT_COUNT 3            // 표시할 추천 수
+#define HINT_MAX_DEPTH 4        // 이 깊이까지 끝나면 스레드 종료 (CPU 계속 점유 안 함)
+#define HINT_ROOT_MOVES 15
+#define HINT_PAUSE_MS 2         // 루트 수 하나마다 쉬는 시간 (입력/출력에 양보)
+
+static pthread_t hintThread;
+static pthread_mutex_t hintLock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int hintStop;
+static int hintRunning = 0;       // 메인 스레드에서만 사용
+static int hintVisible = 0;       // H키로 토글
+static int hintBoard[SIZE][SIZE]; // 탐색용 보드 사본
+static int hintColor = BLACK;
+
 // 후보 수 구조체
 typedef struct {
     int row;
@@ -142,12 +173,22 @@ void initAI(void) {
         }
     }
 
+    // 디스크 분석 캐시 (세션 간 탐색 결과 공유)
+    const char *cachePath = getenv("OMOK_ANACACHE");
+    anaCacheOpen(cachePath ? cachePath : ANACACHE_DEFAULT_FILE, ANACACHE_DEFAULT_CAP);
+
     initialized = 1;
 }
 
 void cleanupAI(void) {
+    anaCacheClose();
     initialized = 0;
 }
+
+// AI 한 수당 시계 (ms, 0 = 난이도별 노드/시간 예산만)
+void setTurnTime(int ms) {
+    aiTurnTimeMs = (ms > 0) ? ms : 0;
+}
 int checkWinBoard(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
     if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) return 0;
     if (board[row][col] != color) return 0;
@@ -209,13 +250,26 @@ static void analyzeLine(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
     }
 }
 
-// 특정 위치에 돌을 놓았을 때 점수 계산
-static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
+// 빈칸 위협 요약 비트 (classifyPosition)
+#define THREAT_FIVE         0x01
+#define THREAT_OPEN_FOUR    0x02    // 열린 4
+#define THREAT_FOUR         0x04    // 닫힌 4 (한쪽 열림)
+#define THREAT_DOUBLE_FOUR  0x08    // 닫힌 4 두 개 이상
+#define THREAT_OPEN_THREE   0x10
+#define THREAT_DOUBLE_THREE 0x20    // 열린3 두 개 이상 (쌍삼 금수)
+#define THREAT_FOUR_THREE   0x40    // 4(양쪽 막힌 4 포함) + 열린3
+#define THREAT_WIN          (THREAT_FIVE | THREAT_OPEN_FOUR | THREAT_DOUBLE_FOUR)
+
+// 특정 위치에 돌을 놓았을 때 점수와 위협 비트를 한 번의 라인 분석으로 계산
+static int classifyPosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color, int* outScore) {
+    *outScore = 0;
     if (board[row][col] != EMPTY) return 0;
 
     int score = 0;
+    int threats = 0;
     int fours = 0;      // 4목 개수
     int openThrees = 0; // 열린 3 개수
+    int anyFour = 0;    // 열린 끝과 무관한 4목
 
     board[row][col] = color;
 
@@ -225,19 +279,24 @@ static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
 
         if (count >= 5) {
             score += SCORE_FIVE;
+            threats |= THREAT_FIVE;
         }
         else if (count == 4) {
+            anyFour = 1;
             if (openEnds == 2) {
                 score += SCORE_OPEN_FOUR;  // 열린 4 = 승리 확정
+                threats |= THREAT_OPEN_FOUR;
             }
             else if (openEnds == 1) {
                 score += SCORE_FOUR;
+                threats |= THREAT_FOUR;
                 fours++;
             }
         }
         else if (count == 3) {
             if (openEnds == 2) {
                 score += SCORE_OPEN_THREE;
+                threats |= THREAT_OPEN_THREE;
                 openThrees++;
             }
             else if (openEnds == 1) {
@@ -267,21 +326,33 @@ static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
     // 쌍사 (4목 2개 이상) = 승리 확정
     if (fours >= 2) {
         score += SCORE_OPEN_FOUR;
+        threats |= THREAT_DOUBLE_FOUR;
     }
 
     // 사삼 (4목 + 열린3) = 승리 확정
     if (fours >= 1 && openThrees >= 1) {
         score += SCORE_OPEN_FOUR / 2;
     }
+    if (anyFour && openThrees >= 1) {
+        threats |= THREAT_FOUR_THREE;
+    }
 
     // 쌍삼 (열린3 2개 이상) = 매우 유리
     if (openThrees >= 2) {
         score += SCORE_FOUR;
+        threats |= THREAT_DOUBLE_THREE;
     }
 
     // 위치 가중치
     score += positionWeight[row][col];
 
+    *outScore = score;
+    return threats;
+}
+
+static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
+    int score;
+    classifyPosition(board, row, col, color, &score);
     return score;
 }
 
@@ -401,6 +472,18 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
     int opponent = (aiColor == BLACK) ? WHITE : BLACK;
     int currentColor = isMaximizing ? aiColor : opponent;
 
+    // 노드 예산(매 노드)과 하드 데드라인(1024 노드마다) 확인
+    aiNodes++;
+    if (aiNodeLimit > 0 && aiNodes >= aiNodeLimit) {
+        aiAborted = 1;
+    }
+    // 힌트 탐색은 hintStop으로 중단 (중단 상태는 스레드별이라 AI 탐색과 섞이지 않음)
+    if (!aiAborted && (aiNodes & 1023) == 0 &&
+        ((aiClockActive && tmHardExpired(&aiClock)) || atomic_load_explicit(&hintStop, memory_order_relaxed))) {
+        aiAborted = 1;
+    }
+    if (aiAborted) return result;
+
     // 기저 조건: 깊이 0
     if (depth == 0) {
         result.score = evaluateBoard(board, aiColor);
@@ -458,6 +541,7 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
 
             MoveResult child = minimax(board, depth - 1, alpha, beta, 0, aiColor);
             board[row][col] = EMPTY;
+            if (aiAborted) return result;
 
             if (child.score > result.score) {
                 result.score = child.score;
@@ -494,6 +578,7 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
 
             MoveResult child = minimax(board, depth - 1, alpha, beta, 1, aiColor);
             board[row][col] = EMPTY;
+            if (aiAborted) return result;
 
             if (child.score < result.score) {
                 result.score = child.score;
@@ -514,130 +599,6 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
     return result;
 }
 
-// 기존 열린3 찾기 (이미 보드에 있는 열린 2개 돌 패턴) - 어려움 모드 방어용
-static int findExistingOpenThree(int board[BOARD_SIZE][BOARD_SIZE], int color, Move blocks[], int maxBlocks) {
-    int blockCount = 0;
-
-    // 보드 전체에서 2개 연속 + 양끝 열린 패턴 찾기
-    for (int row = 0; row < BOARD_SIZE && blockCount < maxBlocks; row++) {
-        for (int col = 0; col < BOARD_SIZE && blockCount < maxBlocks; col++) {
-            if (board[row][col] != color) continue;
-
-            for (int dir = 0; dir < 4; dir++) {
-                // 이 방향으로 시작점인지 확인 (중복 방지)
-                int px = col - DX[dir];
-                int py = row - DY[dir];
-                if (px >= 0 && px < BOARD_SIZE && py >= 0 && py < BOARD_SIZE) {
-                    if (board[py][px] == color) continue;
-                }
-
-                // 연속된 돌 세기
-                int count = 1;
-                int nx = col + DX[dir];
-                int ny = row + DY[dir];
-                while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
-                    count++;
-                    nx += DX[dir];
-                    ny += DY[dir];
-                }
-
-                // 2개 연속인 경우 (열린2 -> 열린3이 될 수 있는 패턴)
-                if (count == 2) {
-                    // 양끝 확인
-                    int endX1 = col - DX[dir];
-                    int endY1 = row - DY[dir];
-                    int endX2 = nx;
-                    int endY2 = ny;
-
-                    int open1 = (endX1 >= 0 && endX1 < BOARD_SIZE && endY1 >= 0 && endY1 < BOARD_SIZE && board[endY1][endX1] == EMPTY);
-                    int open2 = (endX2 >= 0 && endX2 < BOARD_SIZE && endY2 >= 0 && endY2 < BOARD_SIZE && board[endY2][endX2] == EMPTY);
-
-                    // 양끝이 모두 열려있고, 한 칸 더 있어서 3개가 될 수 있는 경우
-                    if (open1 && open2) {
-                        // 양쪽 끝 위치를 막아야 할 후보로 추가
-                        // 먼저, 한쪽 끝에서 한 칸 더 갔을 때도 열려있는지 확인 (진짜 열린2)
-                        int ext1X = endX1 - DX[dir];
-                        int ext1Y = endY1 - DY[dir];
-                        int ext2X = endX2 + DX[dir];
-                        int ext2Y = endY2 + DY[dir];
-
-                        int realOpen1 = (ext1X >= 0 && ext1X < BOARD_SIZE && ext1Y >= 0 && ext1Y < BOARD_SIZE && board[ext1Y][ext1X] == EMPTY) ||
-                                        (ext1X < 0 || ext1X >= BOARD_SIZE || ext1Y < 0 || ext1Y >= BOARD_SIZE);
-                        int realOpen2 = (ext2X >= 0 && ext2X < BOARD_SIZE && ext2Y >= 0 && ext2Y < BOARD_SIZE && board[ext2Y][ext2X] == EMPTY) ||
-                                        (ext2X < 0 || ext2X >= BOARD_SIZE || ext2Y < 0 || ext2Y >= BOARD_SIZE);
-
-                        if (realOpen1 || realOpen2) {
-                            // 양 끝 중 하나를 막기
-                            if (blockCount < maxBlocks) {
-                                blocks[blockCount].row = endY1;
-                                blocks[blockCount].col = endX1;
-                                blockCount++;
-                            }
-                            if (blockCount < maxBlocks) {
-                                blocks[blockCount].row = endY2;
-                                blocks[blockCount].col = endX2;
-                                blockCount++;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return blockCount;
-}
-
-// 열린3 위치 찾기 (앞뒤 뚫린 3개) - 어려움 모드 방어용
-static int findOpenThreePositions(int board[BOARD_SIZE][BOARD_SIZE], int color, Move threats[], int maxThreats) {
-    int threatCount = 0;
-
-    for (int row = 0; row < BOARD_SIZE && threatCount < maxThreats; row++) {
-        for (int col = 0; col < BOARD_SIZE && threatCount < maxThreats; col++) {
-            if (board[row][col] != EMPTY) continue;
-
-            // 이 위치에 돌을 놓았을 때 열린3이 되는지 확인
-            board[row][col] = color;
-
-            for (int dir = 0; dir < 4; dir++) {
-                int count, openEnds;
-                analyzeLine(board, row, col, DX[dir], DY[dir], color, &count, &openEnds);
-
-                if (count == 3 && openEnds == 2) {
-                    // 열린3 발견 - 이 위치를 막아야 함
-                    threats[threatCount].row = row;
-                    threats[threatCount].col = col;
-                    threatCount++;
-                    break;
-                }
-            }
-
-            board[row][col] = EMPTY;
-        }
-    }
-
-    return threatCount;
-}
-
-// 쌍삼(33) 체크 - 금수 확인용
-static int checkDoubleThree(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
-    if (board[row][col] != EMPTY) return 0;
-
-    int openThrees = 0;
-    board[row][col] = color;
-
-    for (int dir = 0; dir < 4; dir++) {
-        int count, openEnds;
-        analyzeLine(board, row, col, DX[dir], DY[dir], color, &count, &openEnds);
-        if (count == 3 && openEnds == 2) {
-            openThrees++;
-        }
-    }
-
-    board[row][col] = EMPTY;
-    return openThrees >= 2;
-}
-
 // 상대방의 연속된 돌(3개 이상)을 찾아서 막아야 할 위치 반환
 static int findBlockingMoves(int board[BOARD_SIZE][BOARD_SIZE], int color, Move blocks[], int maxBlocks) {
     int blockCount = 0;
@@ -747,82 +708,66 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
         return center;
     }
 
-    // ★★★ 최우선: 내가 5목을 만들 수 있으면 무조건 승리! ★★★
+    // 빈칸마다 양쪽 색의 위협을 한 번에 분류 (이후 단계는 이 요약만 읽음)
+    // 점수 경계와 비트의 관계: 닫힌4 하나 + 열린3 셋이어도 SCORE_OPEN_FOUR 미만,
+    // 열린3 하나 + 닫힌3 셋이어도 SCORE_FOUR 미만이므로 아래 비트 판정은 기존 점수 판정과 같다
+    unsigned char aiThreat[BOARD_SIZE * BOARD_SIZE];
+    unsigned char oppThreat[BOARD_SIZE * BOARD_SIZE];
+    int aiScore[BOARD_SIZE * BOARD_SIZE];
+    int oppScore[BOARD_SIZE * BOARD_SIZE];
     for (int i = 0; i < allMoveCount; i++) {
-        board[allMoves[i].row][allMoves[i].col] = aiColor;
-        int canWin = checkWinBoard(board, allMoves[i].row, allMoves[i].col, aiColor);
-        board[allMoves[i].row][allMoves[i].col] = EMPTY;
+        aiThreat[i] = (unsigned char)classifyPosition(board, allMoves[i].row, allMoves[i].col, aiColor, &aiScore[i]);
+        oppThreat[i] = (unsigned char)classifyPosition(board, allMoves[i].row, allMoves[i].col, opponent, &oppScore[i]);
+    }
 
-        if (canWin) {
+    // ★★★ 최우선: 내가 5목을 만들 수 있으면 무조건 승리! ★★★
+    for (int i = 0; i < allMoveCount; i++) {
+        if (aiThreat[i] & THREAT_FIVE) {
             return allMoves[i];  // 즉시 승리!
         }
     }
 
     // === 1단계: 상대 즉시 승리 방어 (상대가 5목 만들 수 있는 곳 막기) ===
     for (int i = 0; i < allMoveCount; i++) {
-        board[allMoves[i].row][allMoves[i].col] = opponent;
-        int opponentWins = checkWinBoard(board, allMoves[i].row, allMoves[i].col, opponent);
-        board[allMoves[i].row][allMoves[i].col] = EMPTY;
-
-        if (opponentWins) {
+        if (oppThreat[i] & THREAT_FIVE) {
             return allMoves[i];  // 막아야 함
         }
     }
 
-    // === 3단계: 열린4 공격 (승리 확정) - 전체 보드 스캔 ===
+    // === 3단계: 열린4 공격 (승리 확정) ===
     for (int i = 0; i < allMoveCount; i++) {
-        int score = evaluatePosition(board, allMoves[i].row, allMoves[i].col, aiColor);
-        if (score >= SCORE_OPEN_FOUR) {
-            if (!checkDoubleThree(board, allMoves[i].row, allMoves[i].col, aiColor)) {
-                return allMoves[i];
-            }
+        if ((aiThreat[i] & THREAT_WIN) && !(aiThreat[i] & THREAT_DOUBLE_THREE)) {
+            return allMoves[i];
         }
     }
 
-    // === 4단계: 상대 열린4 방어 (필수 방어) - 전체 보드 스캔 ===
+    // === 4단계: 상대 열린4 방어 (필수 방어) ===
     for (int i = 0; i < allMoveCount; i++) {
-        int score = evaluatePosition(board, allMoves[i].row, allMoves[i].col, opponent);
-        if (score >= SCORE_OPEN_FOUR) {
+        if (oppThreat[i] & THREAT_WIN) {
             return allMoves[i];
         }
     }
 
-    // === 5단계: 상대 닫힌4 방어 - 전체 보드 스캔 ===
+    // === 5단계: 상대 닫힌4 방어 (쌍삼 자리 포함) ===
     for (int i = 0; i < allMoveCount; i++) {
-        int score = evaluatePosition(board, allMoves[i].row, allMoves[i].col, opponent);
-        if (score >= SCORE_FOUR) {
+        if (oppThreat[i] & (THREAT_FOUR | THREAT_DOUBLE_THREE)) {
             return allMoves[i];
         }
     }
 
-    // === 6단계: 상대 열린3 방어 - 전체 보드 스캔 ===
+    // === 6단계: 상대 열린3 방어 ===
     int bestDefenseIdx = -1;
     int bestDefenseScore = 0;
     for (int i = 0; i < allMoveCount; i++) {
-        int score = evaluatePosition(board, allMoves[i].row, allMoves[i].col, opponent);
-        if (score >= SCORE_OPEN_THREE && score > bestDefenseScore) {
-            bestDefenseScore = score;
+        if ((oppThreat[i] & THREAT_OPEN_THREE) && oppScore[i] > bestDefenseScore) {
+            bestDefenseScore = oppScore[i];
             bestDefenseIdx = i;
         }
     }
 
-    // === 7단계: 사삼 공격 (4+열린3) - 전체 보드 스캔 ===
+    // === 7단계: 사삼 공격 (4+열린3) ===
     for (int i = 0; i < allMoveCount; i++) {
-        if (checkDoubleThree(board, allMoves[i].row, allMoves[i].col, aiColor)) continue;
-
-        board[allMoves[i].row][allMoves[i].col] = aiColor;
-
-        int fours = 0, openThrees = 0;
-        for (int dir = 0; dir < 4; dir++) {
-            int count, openEnds;
-            analyzeLine(board, allMoves[i].row, allMoves[i].col, DX[dir], DY[dir], aiColor, &count, &openEnds);
-            if (count == 4) fours++;
-            if (count == 3 && openEnds == 2) openThrees++;
-        }
-
-        board[allMoves[i].row][allMoves[i].col] = EMPTY;
-
-        if (fours >= 1 && openThrees >= 1) {
+        if ((aiThreat[i] & THREAT_FOUR_THREE) && !(aiThreat[i] & THREAT_DOUBLE_THREE)) {
             return allMoves[i];
         }
     }
@@ -831,11 +776,10 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
     int bestAttackIdx = -1;
     int bestAttackScore = 0;
     for (int i = 0; i < allMoveCount; i++) {
-        if (checkDoubleThree(board, allMoves[i].row, allMoves[i].col, aiColor)) continue;
+        if (aiThreat[i] & THREAT_DOUBLE_THREE) continue;
 
-        int score = evaluatePosition(board, allMoves[i].row, allMoves[i].col, aiColor);
-        if (score > bestAttackScore) {
-            bestAttackScore = score;
+        if (aiScore[i] > bestAttackScore) {
+            bestAttackScore = aiScore[i];
             bestAttackIdx = i;
         }
     }
@@ -859,12 +803,8 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
     int bestTotalScore = -INFINITY_SCORE;
 
     for (int i = 0; i < allMoveCount; i++) {
-        int attackScore = evaluatePosition(board, allMoves[i].row, allMoves[i].col, aiColor);
-        int defenseScore = evaluatePosition(board, allMoves[i].row, allMoves[i].col, opponent);
-        int posWeight = positionWeight[allMoves[i].row][allMoves[i].col];
-
         // 공격 + 방어 + 위치 가중치
-        int totalScore = attackScore * 2 + defenseScore + posWeight;
+        int totalScore = aiScore[i] * 2 + oppScore[i] + positionWeight[allMoves[i].row][allMoves[i].col];
 
         if (totalScore > bestTotalScore) {
             bestTotalScore = totalScore;
@@ -980,28 +920,67 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
         return moves[bestDefenseIdx];
     }
 
-    // === 7단계: Minimax 탐색 ===
-    // 난이도별 깊이 설정
-    int depth;
-    switch (difficulty) {
-    case EASY:
-        depth = 2;
-        // 30% 확률로 랜덤 선택
-        if (rand() % 100 < 30) {
-            int randIdx = rand() % ((moveCount < 5) ? moveCount : 5);
-            return moves[randIdx];
-        }
-        break;
-    case MEDIUM:
-    default:
-        depth = 4;
-        break;
+    // === 7단계: Minimax 탐색 (난이도 = 노드 예산) ===
+    const SearchBudget* budget = &difficultyBudget[(difficulty == EASY) ? EASY : MEDIUM];
+
+    // 분석 캐시 조회
+    unsigned char mb[MB_CELLS];
+    AnaEntry cached;
+    mbFromBoard(mb, board);
+    if (budget->cacheDepth > 0 &&
+        anaCacheLookup(mb, aiColor, ANA_SEARCH_MINIMAX, budget->cacheDepth, &cached)) {
+        return cached.move;
     }
 
-    MoveResult result = minimax(board, depth, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor);
+    // 반복 심화: 노드 예산과 시계 안에서 깊이를 늘림 (중단된 반복 결과는 버림)
+    Move threats[40];
+    int stones = 0;
+    for (int r = 0; r < BOARD_SIZE; r++)
+        for (int c = 0; c < BOARD_SIZE; c++)
+            if (board[r][c] != EMPTY) stones++;
+    int threatCount = findBlockingMoves(board, opponent, threats, 20) +
+                      findBlockingMoves(board, aiColor, threats + 20, 20);
+
+    if (aiTurnTimeMs > 0) {
+        tmStart(&aiClock, aiTurnTimeMs, stones, threatCount);
+    } else {
+        tmStart(&aiClock, budget->timeMs, stones, threatCount);
+        aiClock.softMs = aiClock.hardMs = budget->timeMs;
+    }
+    aiClockActive = 1;
+    aiAborted = 0;
+    aiNodes = 0;
+    aiNodeLimit = budget->nodes;
+
+    int depthDone = 0;
+    long long lastIterNodes = 0;
+    MoveResult result = { 0, -1, -1 };
+    for (int d = 1; d <= budget->maxDepth; d++) {
+        long long iterStart = tmNowMs();
+        long long nodesBefore = aiNodes;
+        MoveResult r = minimax(board, d, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor);
+        if (aiAborted) {
+            // 깊이 1이 끊기면 그때까지 본 루트 수 중 최선 (없으면 정렬 첫 수), 캐시에는 안 넣음
+            if (d == 1) result = r;
+            break;
+        }
+        result = r;
+        depthDone = d;
+        if (r.score >= INFINITY_SCORE - 100 || r.score <= -INFINITY_SCORE + 100) break;
+
+        // 다음 반복이 노드 예산 안에 못 끝날 것 같으면 멈춤
+        if (!tmNodesAllowNext(aiNodes, aiNodes - nodesBefore, &lastIterNodes, aiNodeLimit)) break;
+
+        if (!tmNextIteration(&aiClock, r.row * BOARD_SIZE + r.col, (int)(tmNowMs() - iterStart))) break;
+    }
+    aiClockActive = 0;
+    aiNodeLimit = 0;
 
     if (result.row >= 0 && result.col >= 0) {
         Move bestMove = { result.row, result.col };
+        if (budget->cacheDepth > 0 && depthDone > 0) {
+            anaCacheStore(mb, aiColor, ANA_SEARCH_MINIMAX, depthDone, result.score, bestMove);
+        }
         return bestMove;
     }
 
@@ -1009,6 +988,105 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
     return moves[0];
 }
 
+/*============= 힌트 =====================*/
+// hintLock으로 보호 (워커가 쓰고 printBoard가 읽음)
+static ScoredMove hintMoves[HINT_COUNT];
+static int hintCount = 0;
+static int hintDepth = 0;
+static int hintChanged = 0;
+
+// 깊이를 늘려가며 루트 후보 전부를 전체 창으로 평가해 상위 HINT_COUNT개 공개
+static void* hintWorker(void* arg) {
+    int opponent = (hintColor == BLACK) ? WHITE : BLACK;
+    Move moves[MAX_MOVES];
+    ScoredMove roots[MAX_MOVES];
+    (void)arg;
+
+    int moveCount = getPossibleMoves(hintBoard, moves, MAX_MOVES);
+    for (int i = 0; i < moveCount; i++) {
+        roots[i].row = moves[i].row;
+        roots[i].col = moves[i].col;
+        roots[i].score = evaluatePosition(hintBoard, moves[i].row, moves[i].col, hintColor) +
+                         evaluatePosition(hintBoard, moves[i].row, moves[i].col, opponent);
+    }
+    qsort(roots, moveCount, sizeof(ScoredMove), compareMoves);
+    if (moveCount > HINT_ROOT_MOVES) moveCount = HINT_ROOT_MOVES;
+
+    for (int depth = 1; depth <= HINT_MAX_DEPTH; depth++) {
+        ScoredMove scored[MAX_MOVES];
+        for (int i = 0; i < moveCount; i++) {
+            int row = roots[i].row;
+            int col = roots[i].col;
+
+            hintBoard[row][col] = hintColor;
+            if (checkWinBoard(hintBoard, row, col, hintColor)) {
+                scored[i].score = INFINITY_SCORE;
+            } else {
+                scored[i].score = minimax(hintBoard, depth - 1, -INFINITY_SCORE, INFINITY_SCORE,
+                                          0, hintColor).score;
+            }
+            hintBoard[row][col] = EMPTY;
+            scored[i].row = row;
+            scored[i].col = col;
+
+            if (atomic_load_explicit(&hintStop, memory_order_relaxed)) return NULL;
+            Sleep(HINT_PAUSE_MS);
+        }
+        qsort(scored, moveCount, sizeof(ScoredMove), compareMoves);
+        memcpy(roots, scored, moveCount * sizeof(ScoredMove));   // 다음 깊이는 이 순서로
+
+        pthread_mutex_lock(&hintLock);
+        hintCount = (moveCount < HINT_COUNT) ? moveCount : HINT_COUNT;
+        memcpy(hintMoves, scored, hintCount * sizeof(ScoredMove));
+        hintDepth = depth;
+        hintChanged = 1;
+        pthread_mutex_unlock(&hintLock);
+    }
+    return NULL;
+}
+
+// color 차례의 힌트 탐색 시작 (이미 돌고 있으면 무시)
+static void startHint(int color) {
+    if (hintRunning) return;
+
+    memcpy(hintBoard, board, sizeof(hintBoard));
+    hintColor = color;
+    atomic_store(&hintStop, 0);
+    pthread_mutex_lock(&hintLock);
+    hintCount = 0;
+    hintDepth = 0;
+    hintChanged = 1;
+    pthread_mutex_unlock(&hintLock);
+
+    if (pthread_create(&hintThread, NULL, hintWorker, NULL) == 0) {
+        hintRunning = 1;
+    }
+}
+
+// 힌트 탐색을 즉시 중단하고 스레드 종료를 기다림 (보드를 바꾸기 전에 호출)
+static void stopHint(void) {
+    if (!hintRunning) return;
+
+    atomic_store(&hintStop, 1);
+    pthread_join(hintThread, NULL);
+    hintRunning = 0;
+    atomic_store(&hintStop, 0);
+
+    pthread_mutex_lock(&hintLock);
+    hintCount = 0;
+    hintChanged = 1;
+    pthread_mutex_unlock(&hintLock);
+}
+
+// 표시 중인 힌트가 갱신됐으면 1 (한 번 읽으면 초기화)
+static int takeHintChanged(void) {
+    pthread_mutex_lock(&hintLock);
+    int changed = hintChanged;
+    hintChanged = 0;
+    pthread_mutex_unlock(&hintLock);
+    return changed;
+}
+
 typedef struct {
     int board[SAVE_BOARD_SIZE][SAVE_BOARD_SIZE];
     int currentTurn;
@@ -1073,10 +1151,17 @@ void clearScreen() {
 #endif
 }
 
+// 게임 보드 한 칸 변경 (메일박스 사본도 함께 갱신)
+static void setBoardCell(int y, int x, int color) {
+    board[y][x] = color;
+    boardMailbox[MB_INDEX(y, x)] = (unsigned char)color;
+}
+
 void initBoard() {
     for (int y = 0; y < SIZE; y++)
         for (int x = 0; x < SIZE; x++)
             board[y][x] = EMPTY;
+    mbInit(boardMailbox);
     cursorX = 0;
     cursorY = 0;
 }
@@ -1103,6 +1188,18 @@ void printRemainTime(int remain) {
 
 // 보드 출력
 void printBoard(int remainTime) {
+    ScoredMove hints[HINT_COUNT];
+    int shownHints = 0;
+    int shownDepth = 0;
+
+    if (hintVisible) {
+        pthread_mutex_lock(&hintLock);
+        shownHints = hintCount;
+        shownDepth = hintDepth;
+        memcpy(hints, hintMoves, sizeof(hints));
+        pthread_mutex_unlock(&hintLock);
+    }
+
     gotoxy(0, 1);
     printf("                                        메뉴 M키\n\n");
 
@@ -1122,8 +1219,13 @@ void printBoard(int remainTime) {
                 else printf("[ ]");
             }
             else {
+                int hintRank = 0;
+                for (int i = 0; i < shownHints; i++) {
+                    if (hints[i].row == y && hints[i].col == x) hintRank = i + 1;
+                }
                 if (board[y][x] == BLACK) printf(" X ");
                 else if (board[y][x] == WHITE) printf(" O ");
+                else if (hintRank > 0) printf(" %d ", hintRank);
                 else printf(" . ");
             }
         }
@@ -1135,8 +1237,17 @@ void printBoard(int remainTime) {
     printf("+\n");
 
     printf("흑돌: X  백돌: O\t현재 차례: %s\n", (currentPlayer == BLACK) ? "흑" : "백");
-    printf("착수: B키\n");
-    printf("                              \n");  // 이전 메시지 지우기용 빈 줄
+    printf("착수: B키%s\n", (gameMode == 1) ? "  힌트: H키" : "");
+    if (shownHints > 0) {
+        printf("힌트(깊이 %d):", shownDepth);
+        for (int i = 0; i < shownHints; i++) {
+            printf("  %d) %c%d %+d", i + 1, 'A' + hints[i].row, hints[i].col + 1, hints[i].score);
+        }
+        printf("          \n");
+    }
+    else {
+        printf("%-70s\n", "");  // 이전 메시지/힌트 지우기용 빈 줄
+    }
     fflush(stdout);
 }
 
@@ -1162,7 +1273,8 @@ int placeStone(int x, int y) {
         fflush(stdout);
         return 0;
     }
-    board[y][x] = currentPlayer;
+    stopHint();     // 힌트 스레드가 보는 국면이 바뀌기 전에 중단
+    setBoardCell(y, x, currentPlayer);
     lastMoveX = x;
     lastMoveY = y;
     currentPlayer = (currentPlayer == BLACK) ? WHITE : BLACK;
@@ -1170,6 +1282,7 @@ int placeStone(int x, int y) {
 }
 
 void aiMove() {
+    stopHint();
     Move bestMove = findBestMove(board, WHITE, difficulty);
     if (bestMove.row >= 0 && bestMove.col >= 0) {
         placeStone(bestMove.col, bestMove.row);
@@ -1177,44 +1290,14 @@ void aiMove() {
 }
 
 int checkWin(int x, int y) {
-    int dx[] = { 1,0,1,1 };
-    int dy[] = { 0,1,1,-1 };
     int player = board[y][x];
-
-    for (int dir = 0; dir < 4; dir++) {
-        int count = 1;
-        int nx = x + dx[dir], ny = y + dy[dir];
-        while (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && board[ny][nx] == player) {
-            count++; nx += dx[dir]; ny += dy[dir];
-        }
-        nx = x - dx[dir]; ny = y - dy[dir];
-        while (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && board[ny][nx] == player) {
-            count++; nx -= dx[dir]; ny -= dy[dir];
-        }
-        if (count >= 5) return player;
-    }
-    return 0;
+    return mbCheckWin(boardMailbox, MB_INDEX(y, x), player) ? player : 0;
 }
 
 // 승리 체크
 int checkWinGameplay(int x, int y) {
-    int dx[] = { 1,0,1,1 };
-    int dy[] = { 0,1,1,-1 };
     int player = board[y][x];
-
-    for (int dir = 0; dir < 4; dir++) {
-        int count = 1;
-        int nx = x + dx[dir], ny = y + dy[dir];
-        while (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && board[ny][nx] == player) {
-            count++; nx += dx[dir]; ny += dy[dir];
-        }
-        nx = x - dx[dir]; ny = y - dy[dir];
-        while (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && board[ny][nx] == player) {
-            count++; nx -= dx[dir]; ny -= dy[dir];
-        }
-        if (count >= 5) return player;
-    }
-    return 0;
+    return mbCheckWin(boardMailbox, MB_INDEX(y, x), player) ? player : 0;
 }
 
 /*===============랭킹 관련 함수===============*/
@@ -1938,6 +2021,7 @@ int LoadSelectedGame() {
     for (int i = 0; i < SAVE_BOARD_SIZE && i < SIZE; i++)
         for (int j = 0; j < SAVE_BOARD_SIZE && j < SIZE; j++)
             board[i][j] = data.board[i][j];
+    mbFromBoard(boardMailbox, board);
 
     currentPlayer = data.currentTurn;
     gameMode = data.gameMode;
@@ -2004,6 +2088,9 @@ void gameLoop() {
     DWORD playerTurnStart = GetTickCount();
     int turnActive = 0;
 
+    // AI도 플레이어와 같은 턴 시계를 사용
+    setTurnTime(TURN_TIME_LIMIT * 1000);
+
     while (1) {
         if (gameMode == 1 && currentPlayer == WHITE) { // AI 차례
             aiMove();
@@ -2042,12 +2129,13 @@ if (gameMode == 1) {
         playerTurnStart = GetTickCount();
         turnActive = 1;
     }
+    startHint(BLACK);   // 생각하는 동안 백그라운드로 추천 수 탐색
     int timed_out = 0;
     printBoard(-1);
 
     while (1) {
         DWORD now = GetTickCount();
-        int remain = 10 - (now - playerTurnStart) / 1000;
+        int remain = TURN_TIME_LIMIT - (now - playerTurnStart) / 1000;
         if (remain < 0) remain = 0;
 
         printRemainTime(remain);
@@ -2060,6 +2148,9 @@ if (gameMode == 1) {
             timed_out = 1;
             break;
         }
+        if (hintVisible && takeHintChanged()) {
+            printBoard(-1);
+        }
 
         Sleep(50);
     }
@@ -2124,7 +2215,7 @@ else if (gameMode == 2) {
 
     while (1) {
         DWORD now = GetTickCount();
-        int remain = 10 - (now - playerTurnStart) / 1000;
+        int remain = TURN_TIME_LIMIT - (now - playerTurnStart) / 1000;
         if (remain < 0) remain = 0;
 
         printRemainTime(remain);
@@ -2231,15 +2322,22 @@ else {
                 }
             }
         }
+        else if ((key == 'h' || key == 'H') && gameMode == 1) {
+            hintVisible = !hintVisible;
+        }
         else if (key == 'm' || key == 'M') {
+            stopHint();     // 메뉴에서 불러오기/새 게임으로 보드가 바뀔 수 있음
             showMenu();
         }
 
         printBoard(-1);
         if (gameMode == 2) {
-        printRemainTime(10 - (GetTickCount() - playerTurnStart) / 1000);
+        printRemainTime(TURN_TIME_LIMIT - (GetTickCount() - playerTurnStart) / 1000);
 }
     }
+    stopHint();
+    hintVisible = 0;
+    anaCacheFlush();    // 이번 게임의 탐색 결과를 디스크에 반영
     hideCursor(0);
 }
 
@@ -2338,6 +2436,7 @@ int createRoom(const char* roomName) {
 
     memset(&msg, 0, sizeof(msg));
     msg.type = MSG_ROOM_CREATE;
+    msg.y = BOARD_NET_SIZE;     // 이 클라이언트는 15x15만 그림
     strncpy(msg.nickname, roomName, sizeof(msg.nickname) - 1);
 
     if (net_send_message(netSocket, &msg) != 0) {
@@ -2430,13 +2529,16 @@ int showRoomList(void) {
         if (response.y == 0) {
             printf("  (대기 중인 방이 없습니다)\n\n");
         } else {
-            printf("  번호 | 방 이름            | 방장          | 인원\n");
-            printf("  -----+--------------------+---------------+------\n");
+            /* result의 비트 i = rooms[i]가 19x19 (버전 1 서버는 0, 15x15 방만 있음) */
+            printf("  번호 | 방 이름            | 방장          | 크기  | 인원\n");
+            printf("  -----+--------------------+---------------+-------+------\n");
             for (i = 0; i < response.y; i++) {
-                printf("  %3d  | %-18s | %-13s | %d/2 %s\n",
+                int size = ((response.result >> i) & 1) ? 19 : BOARD_NET_SIZE;
+                printf("  %3d  | %-18s | %-13s | %2dx%-2d | %d/2 %s\n",
                        response.rooms[i].roomId,
                        response.rooms[i].roomName,
                        response.rooms[i].hostName,
+                       size, size,
                        response.rooms[i].playerCount,
                        response.rooms[i].inGame ? "(게임중)" : "");
             }
@@ -2469,6 +2571,7 @@ int joinRoom(int roomId) {
     memset(&msg, 0, sizeof(msg));
     msg.type = MSG_ROOM_JOIN;
     msg.x = roomId;
+    msg.y = BOARD_NET_SIZE;
 
     if (net_send_message(netSocket, &msg) != 0) {
         printf("방 입장 요청 실패\n");
@@ -2637,7 +2740,7 @@ void networkGameLoop(void) {
 
                             if (response.type == MSG_MOVE_ACK) {
                                 /* 착수 성공 */
-                                board[cursorY][cursorX] = myColor;
+                                setBoardCell(cursorY, cursorX, myColor);
                                 lastMoveX = cursorX;
                                 lastMoveY = cursorY;
                                 isMyTurn = 0;
@@ -2648,7 +2751,7 @@ void networkGameLoop(void) {
                                 needRedraw = 1;
                             } else if (response.type == MSG_GAME_END) {
                                 /* 내가 승리 */
-                                board[cursorY][cursorX] = myColor;
+                                setBoardCell(cursorY, cursorX, myColor);
                                 printNetworkBoard();
                                 if (response.result == RESULT_BLACK_WIN) {
                                     printf("\n%s 승리!\n", (myColor == 1) ? player_nickname : opponentNickname);
@@ -2683,7 +2786,7 @@ void networkGameLoop(void) {
             switch (response.type) {
                 case MSG_MOVE:
                     /* 상대방 착수 */
-                    board[response.y][response.x] = response.player;
+                    setBoardCell(response.y, response.x, response.player);
                     lastMoveX = response.x;
                     lastMoveY = response.y;
                     isMyTurn = 1;
@@ -0,0 +1,46 @@
+// AI 모듈 내부 공용 헤더 (minimax.c, mcts.c 등 엔진 소스끼리만 사용)
+
+#ifndef AI_INTERNAL_H
+#define AI_INTERNAL_H
+
+#include "minimax.h"
+#include "mailbox.h"
+
+#define MAX_MOVES_HARD 100  // 어려움 모드: 더 많은 후보 고려
+#define INFINITY_SCORE 10000000
+
+// 보통 탐색(searchMinimax)의 즉시 승리 점수: 남은 깊이가 클수록(루트에 가까울수록) 높다.
+// 반복 심화가 MAX_PV_LENGTH까지 가므로 그 값을 기준으로 잡아 ±INFINITY_SCORE를 넘지 않게 한다.
+#define MINIMAX_MAX_DEPTH MAX_PV_LENGTH
+#define MINIMAX_WIN_SCORE(depth) (INFINITY_SCORE - (MINIMAX_MAX_DEPTH - (depth)))
+
+// 패턴 점수
+typedef enum {
+    SCORE_FIVE      = 1000000,   // 5목 (즉시 승리)
+    SCORE_OPEN_FOUR = 100000,    // 열린 4 (막을 수 없음)
+    SCORE_FOUR      = 15000,     // 닫힌 4 (한쪽 막힘)
+    SCORE_OPEN_THREE= 5000,      // 열린 3
+    SCORE_THREE     = 800,       // 닫힌 3
+    SCORE_OPEN_TWO  = 300,       // 열린 2
+    SCORE_TWO       = 50,        // 닫힌 2
+    SCORE_ONE       = 10         // 1개
+} PatternScore;
+
+// 엔진 내부는 메일박스 보드(mailbox.h)를 사용한다
+
+// 메일박스 idx에 color 돌을 놓았을 때의 패턴 점수 (보드는 호출 후 원상복구)
+int evaluatePosition(unsigned char *mb, int idx, int color);
+
+// 메일박스 보드 전체 평가 (evaluateBoard와 동일)
+int evaluateBoardMb(const unsigned char *mb, int aiColor);
+
+// 기존 돌 주변 3칸 이내 후보 수 (위치 가중치 순)
+int getPossibleMovesHard(const unsigned char *mb, Move moves[], int maxCount);
+
+// color의 3개 이상 연속 라인 양 끝 빈칸 (중복 제외, 최대 maxThreats개)
+int findThreats(const unsigned char *mb, int color, Move threats[], int maxThreats);
+
+// 빈칸 idx가 opponentColor 라인을 끊는 정도 (어려움 모드 방어 점수)
+int getThreatBlockScore(const unsigned char *mb, int idx, int opponentColor);
+
+#endif
@@ -0,0 +1,518 @@
+// 디스크 분석 캐시 (여러 세션이 같은 파일을 공유)
+// 핵심: 대칭 정규화 해시, 덧붙이기 로그 + 메모리 색인, LRU 상한과 압축
+// 덧붙이기와 압축은 옆 잠금 파일(<경로>.lock)의 배타 잠금 안에서만 한다. 압축은 rename으로
+// 파일을 바꾸므로 데이터 파일 자체가 아니라 바뀌지 않는 잠금 파일을 잠근다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "anacache.h"
+#include "mailbox.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#define ANA_VERSION 1
+#define ANA_HEADER_SIZE 16
+#define ANA_RECORD_SIZE 24
+#define ANA_PATH_LEN 260
+
+// 메모리 색인 슬롯 (key 0 = 빈 슬롯, move는 정규 좌표 row * MB_BOARD_SIZE + col)
+typedef struct {
+    unsigned long long key;
+    unsigned int stamp;
+    int score;
+    unsigned char depth;
+    unsigned char kind;
+    unsigned char color;
+    unsigned short move;
+    unsigned char dirty;
+} AnaSlot;
+
+static AnaSlot *slots = NULL;
+static int tableSize = 0;       // 2의 거듭제곱
+static int entryCount = 0;
+static int capacity = 0;
+static int fileRecords = 0;     // 파일에 있는 레코드 수 (중복 포함)
+static int needRewrite = 0;     // 헤더 없음/손상 → 다음 반영 때 새로 씀
+static int mergeLoad = 0;       // 1이면 파일 레코드를 이미 있는 항목 위에 덮지 않고 합침 (압축 전)
+static unsigned int clockStamp = 0;
+static char cachePath[ANA_PATH_LEN];
+static int cacheOpen = 0;
+static int exitHooked = 0;
+
+// Zobrist 키 (고정 시드: 기기가 달라도 같은 키)
+static unsigned long long zobrist[2][MB_BOARD_SIZE * MB_BOARD_SIZE];
+static unsigned long long zobristSide[3];
+static unsigned long long zobristKind[4];
+
+static unsigned long long splitmix64(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void initZobrist(void) {
+    unsigned long long seed = 0x6F6D6F6B41434831ULL;
+    for (int c = 0; c < 2; c++) {
+        for (int i = 0; i < MB_BOARD_SIZE * MB_BOARD_SIZE; i++) {
+            zobrist[c][i] = splitmix64(&seed);
+        }
+    }
+    for (int i = 0; i < 3; i++) zobristSide[i] = splitmix64(&seed);
+    for (int i = 0; i < 4; i++) zobristKind[i] = splitmix64(&seed);
+}
+
+// ========== 대칭 ==========
+// sym 비트: 4 = 전치, 1 = 상하 반전, 2 = 좌우 반전 (이 순서로 적용)
+
+static int symCell(int sym, int row, int col) {
+    const int last = MB_BOARD_SIZE - 1;
+    if (sym & 4) { int t = row; row = col; col = t; }
+    if (sym & 1) row = last - row;
+    if (sym & 2) col = last - col;
+    return row * MB_BOARD_SIZE + col;
+}
+
+static int symCellInverse(int sym, int cell) {
+    const int last = MB_BOARD_SIZE - 1;
+    int row = cell / MB_BOARD_SIZE;
+    int col = cell % MB_BOARD_SIZE;
+    if (sym & 2) col = last - col;
+    if (sym & 1) row = last - row;
+    if (sym & 4) { int t = row; row = col; col = t; }
+    return row * MB_BOARD_SIZE + col;
+}
+
+// 8가지 대칭 해시 중 최솟값과 그 대칭 번호
+static unsigned long long canonicalKey(const unsigned char *mb, int color, int kind, int *symOut) {
+    unsigned long long h[8] = {0};
+
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        const unsigned char *line = &mb[MB_INDEX(row, 0)];
+        for (int col = 0; col < MB_BOARD_SIZE; col++) {
+            if (line[col] == MB_EMPTY) continue;
+            const unsigned long long *z = zobrist[line[col] - 1];
+            for (int s = 0; s < 8; s++) {
+                h[s] ^= z[symCell(s, row, col)];
+            }
+        }
+    }
+
+    int best = 0;
+    for (int s = 1; s < 8; s++) {
+        if (h[s] < h[best]) best = s;
+    }
+
+    unsigned long long key = h[best] ^ zobristSide[color % 3] ^ zobristKind[kind & 3];
+    *symOut = best;
+    return key ? key : 1;
+}
+
+// ========== 메모리 색인 ==========
+
+static int findSlot(unsigned long long key) {
+    int mask = tableSize - 1;
+    int i = (int)(key & (unsigned long long)mask);
+    while (slots[i].key != 0 && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int compareStampDesc(const void *a, const void *b) {
+    unsigned int sa = ((const AnaSlot*)a)->stamp;
+    unsigned int sb = ((const AnaSlot*)b)->stamp;
+    return (sa < sb) ? 1 : (sa > sb) ? -1 : 0;
+}
+
+// 최근 사용 순으로 keep개만 남기고 색인 재구성
+static void evictTo(int keep) {
+    AnaSlot *live = (AnaSlot*)malloc(sizeof(AnaSlot) * (entryCount > 0 ? entryCount : 1));
+    int n = 0;
+
+    if (live == NULL) return;
+    for (int i = 0; i < tableSize; i++) {
+        if (slots[i].key != 0) live[n++] = slots[i];
+    }
+    qsort(live, n, sizeof(AnaSlot), compareStampDesc);
+    if (n > keep) n = keep;
+
+    memset(slots, 0, sizeof(AnaSlot) * tableSize);
+    for (int i = 0; i < n; i++) {
+        slots[findSlot(live[i].key)] = live[i];
+    }
+    entryCount = n;
+    needRewrite = 1;    // 버린 항목이 파일에 남아 있으므로 다음 반영 때 압축
+    free(live);
+}
+
+static void insertSlot(const AnaSlot *entry) {
+    int i = findSlot(entry->key);
+    if (slots[i].key == 0) {
+        // 색인이 3/4 이상 차면 상한까지 먼저 비움
+        if (entryCount + 1 > tableSize / 4 * 3) {
+            evictTo(capacity);
+            i = findSlot(entry->key);
+        }
+        entryCount++;
+    }
+    slots[i] = *entry;
+}
+
+// ========== 레코드 (리틀 엔디언 24바이트) ==========
+// u64 key, u32 stamp, i32 score, u8 depth, u8 kind, u8 color, u8 move, u32 check
+// (19x19는 move가 255를 넘으므로 상위 비트를 color 바이트의 위쪽 4비트에 넣음, 15x15는 항상 0)
+
+static unsigned int recordCheck(const AnaSlot *e) {
+    return (unsigned int)(e->key ^ (e->key >> 32)) ^ e->stamp ^ (unsigned int)e->score ^
+           ((unsigned int)e->depth | ((unsigned int)e->kind << 8) |
+            ((unsigned int)e->color << 16) | ((unsigned int)e->move << 24)) ^
+           ((unsigned int)(e->move >> 8) << 4) ^ 0x9E3779B9u;
+}
+
+static void putU32(unsigned char *p, unsigned int v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned int getU32(const unsigned char *p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+           ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void encodeRecord(unsigned char *p, const AnaSlot *e) {
+    putU32(p, (unsigned int)e->key);
+    putU32(p + 4, (unsigned int)(e->key >> 32));
+    putU32(p + 8, e->stamp);
+    putU32(p + 12, (unsigned int)e->score);
+    p[16] = e->depth;
+    p[17] = e->kind;
+    p[18] = (unsigned char)(e->color | ((e->move >> 8) << 4));
+    p[19] = (unsigned char)e->move;
+    putU32(p + 20, recordCheck(e));
+}
+
+static int decodeRecord(const unsigned char *p, AnaSlot *e) {
+    e->key = (unsigned long long)getU32(p) | ((unsigned long long)getU32(p + 4) << 32);
+    e->stamp = getU32(p + 8);
+    e->score = (int)getU32(p + 12);
+    e->depth = p[16];
+    e->kind = p[17];
+    e->color = p[18] & 0x0F;
+    e->move = (unsigned short)(p[19] | ((p[18] >> 4) << 8));
+    e->dirty = 0;
+    return e->key != 0 && e->move < MB_BOARD_SIZE * MB_BOARD_SIZE &&
+           getU32(p + 20) == recordCheck(e);
+}
+
+static void encodeHeader(unsigned char *p) {
+    memcpy(p, "OACH", 4);
+    putU32(p + 4, ANA_VERSION);
+    putU32(p + 8, ANA_RECORD_SIZE);
+    putU32(p + 12, MB_BOARD_SIZE);
+}
+
+// 파일 내용으로 색인 구성 (잘린 꼬리나 손상 레코드에서 멈춤)
+static void loadImage(const unsigned char *data, long size) {
+    unsigned char header[ANA_HEADER_SIZE];
+
+    encodeHeader(header);
+    if (size < ANA_HEADER_SIZE || memcmp(data, header, ANA_HEADER_SIZE) != 0) {
+        needRewrite = 1;
+        return;
+    }
+
+    long count = (size - ANA_HEADER_SIZE) / ANA_RECORD_SIZE;
+    if (ANA_HEADER_SIZE + count * ANA_RECORD_SIZE != size) needRewrite = 1;
+
+    for (long r = 0; r < count; r++) {
+        AnaSlot e;
+        if (!decodeRecord(data + ANA_HEADER_SIZE + r * ANA_RECORD_SIZE, &e)) {
+            needRewrite = 1;
+            break;
+        }
+        if (mergeLoad) {
+            // 다른 세션이 덧붙인 레코드: 없는 키이거나 이쪽 항목이 더 얕고 미반영이 아닐 때만
+            const AnaSlot *own = &slots[findSlot(e.key)];
+            if (own->key != 0 && (own->dirty || own->depth > e.depth)) continue;
+            if (own->key != 0 && own->stamp > e.stamp) e.stamp = own->stamp;   // 조회로 갱신한 LRU 순서 유지
+            e.dirty = 1;
+        }
+        insertSlot(&e);
+        fileRecords++;
+        if (e.stamp > clockStamp) clockStamp = e.stamp;
+    }
+}
+
+static void loadFile(const char *path) {
+#ifdef _WIN32
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        needRewrite = 1;
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    unsigned char *data = (size > 0) ? (unsigned char*)malloc(size) : NULL;
+    if (data != NULL && fread(data, 1, size, fp) == (size_t)size) {
+        loadImage(data, size);
+    } else {
+        needRewrite = 1;
+    }
+    free(data);
+    fclose(fp);
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0) {
+        needRewrite = 1;
+        return;
+    }
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            loadImage((const unsigned char*)data, (long)st.st_size);
+            munmap(data, (size_t)st.st_size);
+        } else {
+            needRewrite = 1;
+        }
+    } else {
+        needRewrite = 1;
+    }
+    close(fd);
+#endif
+}
+
+// ========== 공개 함수 ==========
+
+static void closeAtExit(void) {
+    anaCacheClose();
+}
+
+int anaCacheOpen(const char *path, int maxEntries) {
+    if (cacheOpen) anaCacheClose();
+    if (path == NULL || strlen(path) >= ANA_PATH_LEN) return 0;
+
+    capacity = (maxEntries > 0) ? maxEntries : ANACACHE_DEFAULT_CAP;
+    tableSize = 1024;
+    while (tableSize < capacity * 2) tableSize <<= 1;
+    slots = (AnaSlot*)calloc(tableSize, sizeof(AnaSlot));
+    if (slots == NULL) return 0;
+
+    strcpy(cachePath, path);
+    entryCount = 0;
+    fileRecords = 0;
+    needRewrite = 0;
+    clockStamp = 0;
+    initZobrist();
+    loadFile(path);
+
+    if (!exitHooked) {
+        atexit(closeAtExit);
+        exitHooked = 1;
+    }
+    cacheOpen = 1;
+    return 1;
+}
+
+int anaCacheIsOpen(void) {
+    return cacheOpen;
+}
+
+int anaCacheLookup(const unsigned char *mb, int color, int kind, int depth, AnaEntry *out) {
+    int sym;
+
+    if (!cacheOpen) return 0;
+
+    unsigned long long key = canonicalKey(mb, color, kind, &sym);
+    AnaSlot *e = &slots[findSlot(key)];
+    if (e->key == 0 || e->depth < depth) return 0;
+
+    int cell = symCellInverse(sym, e->move);
+    int row = cell / MB_BOARD_SIZE;
+    int col = cell % MB_BOARD_SIZE;
+    // 해시 충돌 대비: 빈칸이 아니면 버림
+    if (mb[MB_INDEX(row, col)] != MB_EMPTY) return 0;
+
+    // LRU 순서는 메모리에서만 갱신 (조회마다 레코드를 덧붙이지 않음, 압축할 때 함께 기록)
+    e->stamp = ++clockStamp;
+    out->depth = e->depth;
+    out->score = e->score;
+    out->move.row = row;
+    out->move.col = col;
+    return 1;
+}
+
+void anaCacheStore(const unsigned char *mb, int color, int kind, int depth, int score, Move move) {
+    int sym;
+
+    if (!cacheOpen || move.row < 0 || move.col < 0) return;
+
+    unsigned long long key = canonicalKey(mb, color, kind, &sym);
+    AnaSlot *old = &slots[findSlot(key)];
+    if (old->key != 0 && old->depth > depth) return;
+
+    AnaSlot e;
+    e.key = key;
+    e.stamp = ++clockStamp;
+    e.score = score;
+    e.depth = (unsigned char)(depth > 255 ? 255 : depth);
+    e.kind = (unsigned char)kind;
+    e.color = (unsigned char)color;
+    e.move = (unsigned short)symCell(sym, move.row, move.col);
+    e.dirty = 1;
+    insertSlot(&e);
+}
+
+// ========== 잠금 (여러 프로세스) ==========
+
+#ifdef _WIN32
+static HANDLE lockHandle = INVALID_HANDLE_VALUE;
+#else
+static int lockFd = -1;
+#endif
+
+// 잠금 파일을 배타로 잠금 (다른 프로세스가 반영 중이면 끝날 때까지 기다림). 성공 시 1
+static int lockCacheFile(void) {
+    char lockPath[ANA_PATH_LEN + 8];
+
+    snprintf(lockPath, sizeof(lockPath), "%s.lock", cachePath);
+#ifdef _WIN32
+    OVERLAPPED overlapped;
+    lockHandle = CreateFileA(lockPath, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (lockHandle == INVALID_HANDLE_VALUE) return 0;
+    memset(&overlapped, 0, sizeof(overlapped));
+    if (!LockFileEx(lockHandle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) {
+        CloseHandle(lockHandle);
+        lockHandle = INVALID_HANDLE_VALUE;
+        return 0;
+    }
+#else
+    lockFd = open(lockPath, O_RDWR | O_CREAT, 0644);
+    if (lockFd < 0) return 0;
+    if (flock(lockFd, LOCK_EX) != 0) {
+        close(lockFd);
+        lockFd = -1;
+        return 0;
+    }
+#endif
+    return 1;
+}
+
+static void unlockCacheFile(void) {
+#ifdef _WIN32
+    OVERLAPPED overlapped;
+    if (lockHandle == INVALID_HANDLE_VALUE) return;
+    memset(&overlapped, 0, sizeof(overlapped));
+    UnlockFileEx(lockHandle, 0, 1, 0, &overlapped);
+    CloseHandle(lockHandle);
+    lockHandle = INVALID_HANDLE_VALUE;
+#else
+    if (lockFd < 0) return;
+    flock(lockFd, LOCK_UN);
+    close(lockFd);
+    lockFd = -1;
+#endif
+}
+
+// 살아있는 항목만 임시 파일에 쓰고 교체 (잠금 안에서 부름)
+// 열고 난 뒤 다른 세션이 덧붙인 레코드를 먼저 합쳐 압축 때 잃지 않게 한다.
+static int rewriteFile(void) {
+    char tmpPath[ANA_PATH_LEN + 4];
+    unsigned char buf[ANA_RECORD_SIZE];
+    FILE *fp;
+
+    mergeLoad = 1;
+    loadFile(cachePath);
+    mergeLoad = 0;
+    if (entryCount > capacity) evictTo(capacity);
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", cachePath);
+    fp = fopen(tmpPath, "wb");
+    if (fp == NULL) return 0;
+
+    encodeHeader(buf);
+    int ok = fwrite(buf, 1, ANA_HEADER_SIZE, fp) == ANA_HEADER_SIZE;
+    for (int i = 0; ok && i < tableSize; i++) {
+        if (slots[i].key == 0) continue;
+        encodeRecord(buf, &slots[i]);
+        ok = fwrite(buf, 1, ANA_RECORD_SIZE, fp) == ANA_RECORD_SIZE;
+        slots[i].dirty = 0;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    if (!ok) {
+        remove(tmpPath);
+        return 0;
+    }
+
+#ifdef _WIN32
+    remove(cachePath);
+#endif
+    if (rename(tmpPath, cachePath) != 0) return 0;
+
+    fileRecords = entryCount;
+    needRewrite = 0;
+    return 1;
+}
+
+// 잠금 안에서 반영 (덧붙이기 또는 압축)
+static int flushLocked(void) {
+    unsigned char buf[ANA_RECORD_SIZE];
+    int dirtyCount = 0;
+
+    for (int i = 0; i < tableSize; i++) {
+        if (slots[i].key != 0 && slots[i].dirty) dirtyCount++;
+    }
+
+    // 상한 초과 또는 중복 레코드가 절반 이상이면 압축
+    if (entryCount > capacity) evictTo(capacity);
+    if (needRewrite || fileRecords + dirtyCount > 2 * entryCount + 1024) {
+        return rewriteFile();
+    }
+    if (dirtyCount == 0) return 1;
+
+    FILE *fp = fopen(cachePath, "ab");
+    if (fp == NULL) return 0;
+
+    int ok = 1;
+    for (int i = 0; ok && i < tableSize; i++) {
+        if (slots[i].key == 0 || !slots[i].dirty) continue;
+        encodeRecord(buf, &slots[i]);
+        ok = fwrite(buf, 1, ANA_RECORD_SIZE, fp) == ANA_RECORD_SIZE;
+        slots[i].dirty = 0;
+        fileRecords++;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    return ok;
+}
+
+int anaCacheFlush(void) {
+    if (!cacheOpen) return 0;
+    if (!lockCacheFile()) return 0;
+    int ok = flushLocked();
+    unlockCacheFile();
+    return ok;
+}
+
+void anaCacheClose(void) {
+    if (!cacheOpen) return;
+    anaCacheFlush();
+    free(slots);
+    slots = NULL;
+    tableSize = 0;
+    entryCount = 0;
+    cacheOpen = 0;
+}
@@ -0,0 +1,47 @@
+// 디스크 분석 캐시 헤더 (국면 → 탐색 깊이, 점수, 최선 수)
+//
+// 대칭 8가지 중 최소 해시를 정규 키로 사용하므로 회전/반전된 같은 국면도 공유한다.
+// 파일은 고정 크기 레코드를 뒤에 덧붙이는 로그 형식이며, 시작 시 매핑해서 메모리
+// 색인으로 읽어 들인다. 같은 키는 뒤쪽 레코드가 우선한다.
+// 게임이 끝날 때 anaCacheFlush로 새 결과를 덧붙이고, 항목 수가 상한을 넘거나
+// 중복 레코드가 많아지면 오래 안 쓴(LRU) 항목부터 버리고 파일을 다시 쓴다.
+// 조회는 LRU 순서를 메모리에서만 바꾸고, 그 순서는 파일을 다시 쓸 때 기록된다.
+// 여러 프로세스가 같은 파일을 써도 된다: 반영은 <경로>.lock 배타 잠금 안에서 하고,
+// 다시 쓰기 전에 다른 프로세스가 덧붙인 레코드를 합친다.
+
+#ifndef ANACACHE_H
+#define ANACACHE_H
+
+#include "minimax.h"
+
+#if BOARD_SIZE == 15
+#define ANACACHE_DEFAULT_FILE "omok_anacache.bin"
+#else
+#define ANACACHE_DEFAULT_FILE "omok_anacache19.bin"    // 크기가 다른 파일은 헤더가 달라 새로 써 버리므로 분리
+#endif
+#define ANACACHE_DEFAULT_CAP 65536      // 기본 최대 항목 수 (레코드 24바이트)
+
+// 탐색 종류 (같은 국면이라도 탐색 방식이 다르면 다른 항목)
+#define ANA_SEARCH_MINIMAX 1            // 쉬움/보통 minimax
+#define ANA_SEARCH_HARD 2               // 어려움 minimaxHard
+
+typedef struct {
+    int depth;
+    int score;
+    Move move;
+} AnaEntry;
+
+// path 파일을 열어 색인 구성 (없으면 새로 만듦). 성공 시 1
+int anaCacheOpen(const char *path, int maxEntries);
+int anaCacheIsOpen(void);
+
+// mb는 메일박스 보드. depth 이상으로 탐색된 결과가 있으면 1
+int anaCacheLookup(const unsigned char *mb, int color, int kind, int depth, AnaEntry *out);
+
+// 결과 기록 (메모리에만, 기존 항목보다 깊거나 같을 때만 교체)
+void anaCacheStore(const unsigned char *mb, int color, int kind, int depth, int score, Move move);
+
+int anaCacheFlush(void);    // 변경분 디스크 반영 (필요하면 압축). 성공 시 1
+void anaCacheClose(void);   // 반영 후 닫기
+
+#endif
@@ -0,0 +1,530 @@
+// 저장된 대국/국면 일괄 분석 도구 (오프라인)
+// 입력 파일의 모든 국면을 작업 스레드 풀에 나눠 엔진으로 분석하고(스레드마다 독립된
+// 탐색 상태), 한 대국의 국면이 모두 끝나는 대로 악수, 놓친 승리, 형세 역전 보고를
+// 한 줄짜리 JSON으로 바로 출력 파일에 쓴다.
+//
+// 입력 (JSON 배열, 파일 여러 개 가능):
+//   대국 기록: {"id": "...", "moves": [[row, col], ...]}          (흑부터 교대)
+//   저장 국면: game_saves.json 항목 {"board": [[...]], "currentTurn": 1|2, ...}
+//
+// 사용법: ./omok_analyze [-t 스레드 수] [-b 국면당 ms] [-o 출력 파일] 입력.json ...
+// -b 0(기본)이면 국면마다 고정 깊이라 결과가 실행마다 같다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "ai_internal.h"
+#include "timeman.h"
+#include "cJSON.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#define MAX_THREADS 64
+#define ID_LEN 64
+
+// 판정 기준 (둘 차례 관점 점수)
+#define WIN_SCORE (INFINITY_SCORE - 100)    // 탐색이 찾은 강제 승리
+#define BLUNDER_LOSS SCORE_FOUR             // 최선 수보다 이만큼 나쁘면 악수
+#define SWING_MIN SCORE_OPEN_THREE          // 우세가 뒤집히며 이만큼 움직이면 형세 역전
+
+typedef struct {
+    int score;          // 둘 차례 관점
+    int depth;
+    Move best;          // row < 0이면 둘 곳 없음
+} PosResult;
+
+typedef struct {
+    char id[ID_LEN];
+    const char *source;
+    int isRecord;                   // 1 = 수순 있는 대국, 0 = 저장 국면 하나
+    int (*start)[BOARD_SIZE];       // 시작 보드 (저장 국면만, 대국 기록은 빈 보드)
+    int startColor;
+    Move *moves;
+    int moveCount;                  // 분석할 수 (5목을 만든 수에서 끊음)
+    int winner;                     // 마지막 수로 5목이 된 색 (EMPTY = 없음)
+    int posCount;                   // 분석할 국면 수
+    int remaining;                  // 남은 국면 수 (jobLock)
+    PosResult *results;
+} Game;
+
+static Game *games = NULL;
+static int gameCount = 0;
+static int gameCapacity = 0;
+
+// 작업 분배: 대국 순서대로 국면을 하나씩 가져감 (앞 대국부터 끝나 바로 기록됨)
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static int nextGame = 0;
+static int nextPos = 0;
+static long long positionsDone = 0;
+
+static pthread_mutex_t outputLock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *output = NULL;
+static int budgetMs = 0;
+static long long totalBlunders = 0;
+static long long totalMissedWins = 0;
+
+static int onlineCores(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+static const char *colorName(int color) {
+    return (color == BLACK) ? "black" : "white";
+}
+
+static int opponentOf(int color) {
+    return (color == BLACK) ? WHITE : BLACK;
+}
+
+// ============================================================
+// 입력 읽기
+// ============================================================
+
+static char *readFile(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (length < 0) {
+        fclose(fp);
+        return NULL;
+    }
+
+    char *buffer = (char*)malloc(length + 1);
+    if (buffer == NULL) {
+        fclose(fp);
+        return NULL;
+    }
+    size_t readBytes = fread(buffer, 1, length, fp);
+    buffer[readBytes] = '\0';
+    fclose(fp);
+    return buffer;
+}
+
+static Game *newGame(const char *source, const cJSON *entry, int index) {
+    if (gameCount == gameCapacity) {
+        int capacity = gameCapacity ? gameCapacity * 2 : 256;
+        Game *grown = (Game*)realloc(games, capacity * sizeof(Game));
+        if (grown == NULL) return NULL;
+        games = grown;
+        gameCapacity = capacity;
+    }
+
+    Game *g = &games[gameCount];
+    memset(g, 0, sizeof(Game));
+    g->source = source;
+
+    const cJSON *id = cJSON_GetObjectItemCaseSensitive(entry, "id");
+    const cJSON *timestamp = cJSON_GetObjectItemCaseSensitive(entry, "timestamp");
+    if (cJSON_IsString(id)) {
+        snprintf(g->id, ID_LEN, "%s", id->valuestring);
+    } else if (cJSON_IsNumber(id)) {
+        snprintf(g->id, ID_LEN, "%d", id->valueint);
+    } else if (cJSON_IsString(timestamp) && timestamp->valuestring[0] != '\0') {
+        snprintf(g->id, ID_LEN, "%s", timestamp->valuestring);
+    } else {
+        snprintf(g->id, ID_LEN, "#%d", index);
+    }
+    return g;
+}
+
+// 대국 기록: 수순을 두어 보며 잘못된 수에서 끊고, 5목이 된 수 뒤는 버림
+static int loadRecord(Game *g, const cJSON *moves) {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int count = cJSON_GetArraySize(moves);
+
+    memset(board, 0, sizeof(board));
+    g->isRecord = 1;
+    g->startColor = BLACK;
+    g->moves = (Move*)malloc((count > 0 ? count : 1) * sizeof(Move));
+    if (g->moves == NULL) return 0;
+
+    int color = BLACK;
+    for (int i = 0; i < count; i++) {
+        const cJSON *move = cJSON_GetArrayItem(moves, i);
+        const cJSON *row = cJSON_GetArrayItem(move, 0);
+        const cJSON *col = cJSON_GetArrayItem(move, 1);
+        if (!cJSON_IsNumber(row) || !cJSON_IsNumber(col) ||
+            row->valueint < 0 || row->valueint >= BOARD_SIZE ||
+            col->valueint < 0 || col->valueint >= BOARD_SIZE ||
+            board[row->valueint][col->valueint] != EMPTY) {
+            fprintf(stderr, "%s %s: %d번째 수가 잘못되어 그 앞까지만 분석\n", g->source, g->id, i + 1);
+            break;
+        }
+
+        board[row->valueint][col->valueint] = color;
+        g->moves[g->moveCount].row = row->valueint;
+        g->moves[g->moveCount].col = col->valueint;
+        g->moveCount++;
+        if (checkWinBoard(board, row->valueint, col->valueint, color)) {
+            g->winner = color;
+            break;
+        }
+        color = opponentOf(color);
+    }
+
+    // 각 수 전 국면 + (승부가 안 났으면) 마지막 수 뒤 국면
+    g->posCount = g->moveCount + (g->winner == EMPTY ? 1 : 0);
+    return 1;
+}
+
+// 저장 국면: 빈 슬롯(보드 없음, 돌 없음)은 건너뜀
+static int loadSave(Game *g, const cJSON *boardJson, const cJSON *turn) {
+    int stones = 0;
+
+    if (cJSON_GetArraySize(boardJson) != BOARD_SIZE) return 0;
+    g->start = (int (*)[BOARD_SIZE])calloc(BOARD_SIZE, sizeof(*g->start));
+    if (g->start == NULL) return 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        const cJSON *line = cJSON_GetArrayItem(boardJson, row);
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            const cJSON *cell = cJSON_GetArrayItem(line, col);
+            int v = cJSON_IsNumber(cell) ? cell->valueint : EMPTY;
+            if (v == BLACK || v == WHITE) {
+                g->start[row][col] = v;
+                stones++;
+            }
+        }
+    }
+    if (stones == 0) {
+        free(g->start);
+        g->start = NULL;
+        return 0;
+    }
+
+    g->isRecord = 0;
+    g->startColor = (cJSON_IsNumber(turn) && turn->valueint == WHITE) ? WHITE : BLACK;
+    g->posCount = 1;
+    return 1;
+}
+
+static int loadFile(const char *path) {
+    char *text = readFile(path);
+    if (text == NULL) {
+        fprintf(stderr, "%s: 읽을 수 없음\n", path);
+        return 0;
+    }
+    cJSON *root = cJSON_Parse(text);
+    free(text);
+    if (!cJSON_IsArray(root)) {
+        fprintf(stderr, "%s: JSON 배열이 아님\n", path);
+        cJSON_Delete(root);
+        return 0;
+    }
+
+    int loaded = 0;
+    int size = cJSON_GetArraySize(root);
+    for (int i = 0; i < size; i++) {
+        const cJSON *entry = cJSON_GetArrayItem(root, i);
+        const cJSON *moves = cJSON_GetObjectItemCaseSensitive(entry, "moves");
+        const cJSON *boardJson = cJSON_GetObjectItemCaseSensitive(entry, "board");
+
+        Game *g = newGame(path, entry, i);
+        if (g == NULL) break;
+
+        int ok = 0;
+        if (cJSON_IsArray(moves)) ok = loadRecord(g, moves);
+        else if (cJSON_IsArray(boardJson)) {
+            ok = loadSave(g, boardJson, cJSON_GetObjectItemCaseSensitive(entry, "currentTurn"));
+        }
+        if (!ok || g->posCount == 0) {
+            free(g->moves);
+            continue;
+        }
+
+        g->remaining = g->posCount;
+        g->results = (PosResult*)calloc(g->posCount, sizeof(PosResult));
+        if (g->results == NULL) {
+            free(g->moves);
+            free(g->start);
+            break;
+        }
+        gameCount++;
+        loaded++;
+    }
+
+    cJSON_Delete(root);
+    return loaded;
+}
+
+// ============================================================
+// 보고서 (한 대국이 끝난 스레드가 outputLock 안에서 씀)
+// ============================================================
+
+static cJSON *moveJson(Move m) {
+    int pair[2] = {m.row, m.col};
+    return cJSON_CreateIntArray(pair, 2);
+}
+
+// ply번째 수를 둔 쪽 관점에서 그 수의 가치 (다음 국면 최선 점수의 반대, 5목이면 승리)
+static int playedValue(const Game *g, int ply) {
+    if (ply + 1 >= g->posCount) return INFINITY_SCORE;    // 5목을 만든 마지막 수
+    return -g->results[ply + 1].score;
+}
+
+static cJSON *recordReport(const Game *g, int *blunders, int *missedWins) {
+    cJSON *report = cJSON_CreateObject();
+    cJSON *evals = cJSON_CreateArray();
+    cJSON *blunderList = cJSON_CreateArray();
+    cJSON *missedList = cJSON_CreateArray();
+    cJSON *swingList = cJSON_CreateArray();
+
+    cJSON_AddStringToObject(report, "id", g->id);
+    cJSON_AddStringToObject(report, "source", g->source);
+    cJSON_AddNumberToObject(report, "moves", g->moveCount);
+    cJSON_AddStringToObject(report, "result", g->winner == EMPTY ? "none" : colorName(g->winner));
+
+    // 국면별 형세 (흑 관점)
+    for (int p = 0; p < g->posCount; p++) {
+        int color = (p % 2 == 0) ? BLACK : WHITE;
+        int score = g->results[p].score;
+        cJSON_AddItemToArray(evals, cJSON_CreateNumber(color == BLACK ? score : -score));
+    }
+
+    for (int ply = 0; ply < g->moveCount; ply++) {
+        const PosResult *before = &g->results[ply];
+        int color = (ply % 2 == 0) ? BLACK : WHITE;
+        Move played = g->moves[ply];
+        int value = playedValue(g, ply);
+        int loss = before->score - value;
+        int isBest = (played.row == before->best.row && played.col == before->best.col);
+
+        if (before->best.row < 0 || isBest) continue;
+
+        if (before->score >= WIN_SCORE && value < WIN_SCORE) {
+            // 강제 승리가 있었는데 놓침
+            cJSON *item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "ply", ply + 1);
+            cJSON_AddStringToObject(item, "color", colorName(color));
+            cJSON_AddItemToObject(item, "played", moveJson(played));
+            cJSON_AddItemToObject(item, "best", moveJson(before->best));
+            cJSON_AddItemToArray(missedList, item);
+            (*missedWins)++;
+        } else if (loss >= BLUNDER_LOSS) {
+            cJSON *item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "ply", ply + 1);
+            cJSON_AddStringToObject(item, "color", colorName(color));
+            cJSON_AddItemToObject(item, "played", moveJson(played));
+            cJSON_AddItemToObject(item, "best", moveJson(before->best));
+            cJSON_AddNumberToObject(item, "loss", loss);
+            cJSON_AddItemToArray(blunderList, item);
+            (*blunders)++;
+        }
+    }
+
+    // 형세 역전: 수 하나로 흑 관점 점수의 부호가 바뀌고 크게 움직인 곳
+    for (int ply = 0; ply + 1 < g->posCount; ply++) {
+        int sign = (ply % 2 == 0) ? 1 : -1;
+        int before = sign * g->results[ply].score;
+        int after = -sign * g->results[ply + 1].score;
+        int delta = after - before;
+        if ((before > 0) != (after > 0) && (delta >= SWING_MIN || delta <= -SWING_MIN)) {
+            cJSON *item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "ply", ply + 1);
+            cJSON_AddNumberToObject(item, "before", before);
+            cJSON_AddNumberToObject(item, "after", after);
+            cJSON_AddItemToArray(swingList, item);
+        }
+    }
+
+    cJSON_AddItemToObject(report, "blunders", blunderList);
+    cJSON_AddItemToObject(report, "missedWins", missedList);
+    cJSON_AddItemToObject(report, "swings", swingList);
+    cJSON_AddItemToObject(report, "evals", evals);
+    return report;
+}
+
+static cJSON *saveReport(const Game *g) {
+    const PosResult *r = &g->results[0];
+    cJSON *report = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(report, "id", g->id);
+    cJSON_AddStringToObject(report, "source", g->source);
+    cJSON_AddStringToObject(report, "toMove", colorName(g->startColor));
+    if (r->best.row >= 0) {
+        cJSON_AddItemToObject(report, "best", moveJson(r->best));
+    } else {
+        cJSON_AddNullToObject(report, "best");
+    }
+    cJSON_AddNumberToObject(report, "score", r->score);
+    cJSON_AddNumberToObject(report, "depth", r->depth);
+    cJSON_AddBoolToObject(report, "winning", r->score >= WIN_SCORE);
+    cJSON_AddBoolToObject(report, "losing", r->score <= -WIN_SCORE);
+    return report;
+}
+
+static void writeReport(Game *g) {
+    int blunders = 0, missedWins = 0;
+    cJSON *report = g->isRecord ? recordReport(g, &blunders, &missedWins) : saveReport(g);
+    char *line = cJSON_PrintUnformatted(report);
+
+    pthread_mutex_lock(&outputLock);
+    if (line != NULL) {
+        fputs(line, output);
+        fputc('\n', output);
+        fflush(output);
+    }
+    totalBlunders += blunders;
+    totalMissedWins += missedWins;
+    pthread_mutex_unlock(&outputLock);
+
+    cJSON_free(line);
+    cJSON_Delete(report);
+
+    // 보고가 끝난 대국의 메모리는 바로 반환
+    free(g->results);
+    free(g->moves);
+    free(g->start);
+    g->results = NULL;
+    g->moves = NULL;
+    g->start = NULL;
+}
+
+// ============================================================
+// 작업 스레드
+// ============================================================
+
+static int takeJob(int *gameIndex, int *pos) {
+    int ok = 0;
+    pthread_mutex_lock(&jobLock);
+    if (nextGame < gameCount) {
+        *gameIndex = nextGame;
+        *pos = nextPos;
+        if (++nextPos >= games[nextGame].posCount) {
+            nextGame++;
+            nextPos = 0;
+        }
+        ok = 1;
+    }
+    pthread_mutex_unlock(&jobLock);
+    return ok;
+}
+
+// pos번째 국면 만들기 (시작 보드 + 앞의 수들), 반환값은 둘 차례
+static int buildPosition(const Game *g, int pos, int board[BOARD_SIZE][BOARD_SIZE]) {
+    int color = g->startColor;
+
+    if (g->start != NULL) memcpy(board, g->start, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
+    else memset(board, 0, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
+
+    for (int i = 0; i < pos; i++) {
+        board[g->moves[i].row][g->moves[i].col] = color;
+        color = opponentOf(color);
+    }
+    return color;
+}
+
+static void *analyzeWorker(void *arg) {
+    int gameIndex, pos;
+    (void)arg;
+
+    while (takeJob(&gameIndex, &pos)) {
+        Game *g = &games[gameIndex];
+        int board[BOARD_SIZE][BOARD_SIZE];
+        int color = buildPosition(g, pos, board);
+
+        PvLine line;
+        PosResult *r = &g->results[pos];
+        if (findBestMoves(board, color, 1, budgetMs, &line) > 0) {
+            r->score = line.score;
+            r->depth = line.depth;
+            r->best = line.move;
+        } else {
+            r->best.row = r->best.col = -1;     // 보드가 가득 참
+        }
+
+        pthread_mutex_lock(&jobLock);
+        int done = (--g->remaining == 0);
+        positionsDone++;
+        pthread_mutex_unlock(&jobLock);
+
+        if (done) writeReport(g);
+    }
+
+    cleanupSearchThread();
+    return NULL;
+}
+
+static void printUsage(void) {
+    fprintf(stderr, "사용법: ./omok_analyze [-t 스레드 수] [-b 국면당 ms] [-o 출력 파일] 입력.json ...\n");
+    fprintf(stderr, "  입력: 대국 기록 {\"id\", \"moves\": [[row, col], ...]} 또는 game_saves.json 항목의 배열\n");
+    fprintf(stderr, "  출력: 대국마다 JSON 한 줄 (악수, 놓친 승리, 형세 역전, 국면별 형세)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int threads = onlineCores();
+    const char *outPath = NULL;
+    int inputs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            budgetMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            loadFile(argv[i]);
+            inputs++;
+        }
+    }
+    if (inputs == 0) {
+        printUsage();
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (budgetMs < 0) budgetMs = 0;
+
+    output = outPath ? fopen(outPath, "w") : stdout;
+    if (output == NULL) {
+        fprintf(stderr, "%s: 쓸 수 없음\n", outPath);
+        return 1;
+    }
+
+    long long positions = 0;
+    for (int i = 0; i < gameCount; i++) positions += games[i].posCount;
+    fprintf(stderr, "대국/국면 %d개, 분석할 국면 %lld개, 스레드 %d개\n", gameCount, positions, threads);
+
+    initAI();
+    long long start = tmNowMs();
+
+    pthread_t workers[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, analyzeWorker, NULL) != 0) break;
+        started++;
+    }
+    if (started == 0) analyzeWorker(NULL);
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    long long elapsed = tmNowMs() - start;
+    fprintf(stderr, "완료: 국면 %lld개, %.1f초 (%.0f 국면/초), 악수 %lld, 놓친 승리 %lld\n",
+            positionsDone, elapsed / 1000.0,
+            elapsed > 0 ? positionsDone * 1000.0 / elapsed : 0.0,
+            totalBlunders, totalMissedWins);
+
+    if (output != stdout) fclose(output);
+    free(games);
+    cleanupAI();
+    return 0;
+}
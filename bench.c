@@ -0,0 +1,724 @@
+// 엔진 커널 마이크로벤치마크
+// 돌 밀도별로 고정 시드 보드 모음을 만들고, 커널 하나씩 보드 모음 전체를 반복 실행해
+// 호출당 ns(중앙값, p99)를 잰다. 같은 실행에서 2차원 배열 기반 참조 구현의 출력 해시와
+// 비교해, 최적화한 커널이 결과를 바꾸지 않았는지 확인한다.
+//
+// 사용법: ./omok_bench [반복 수] [커널 이름 일부]
+// 불일치가 하나라도 있으면 종료 코드 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ai_internal.h"
+#include "forbid.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#define CORPUS_BOARDS 64        // 밀도당 보드 수
+#define WARMUP_REPS 10
+#define DEFAULT_REPS 200
+#define MAX_REPS 10000
+#define ALL_MOVES (BOARD_SIZE * BOARD_SIZE)
+
+// 밀도 (보드 위 돌 수): 개국, 초반, 중반, 후반, 거의 가득
+static const int DENSITIES[] = {6, 16, 40, 80, 140};
+#define DENSITY_COUNT ((int)(sizeof(DENSITIES) / sizeof(DENSITIES[0])))
+
+static const int DX[4] = {1, 0, 1, 1};
+static const int DY[4] = {0, 1, 1, -1};
+
+typedef struct {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    unsigned char mb[MB_CELLS];
+} BenchBoard;
+
+static BenchBoard corpus[DENSITY_COUNT][CORPUS_BOARDS];
+
+static long long nowNs(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (long long)(t.QuadPart * 1000000000.0 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+static unsigned long long nextRandom(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// 출력 해시 (FNV-1a 방식, 값 하나씩 섞음)
+#define HASH_INIT 0xCBF29CE484222325ULL
+
+static unsigned long long mixHash(unsigned long long h, long long value) {
+    return (h ^ (unsigned long long)value) * 0x100000001B3ULL;
+}
+
+// 순서와 무관한 칸 해시 (동점 정렬 순서가 달라도 같은 집합이면 같은 값)
+static unsigned long long cellHash(int row, int col) {
+    unsigned long long state = (unsigned long long)(row * BOARD_SIZE + col);
+    return nextRandom(&state);
+}
+
+// 실제 대국처럼 모여 있는 보드: 기존 돌 주변 2칸 이내에 흑백 교대로 둔다
+static void buildBoard(BenchBoard *b, int stones, unsigned long long *seed) {
+    memset(b->board, 0, sizeof(b->board));
+
+    int center = BOARD_SIZE / 2;
+    int row = center - 2 + (int)(nextRandom(seed) % 5);
+    int col = center - 2 + (int)(nextRandom(seed) % 5);
+    b->board[row][col] = BLACK;
+
+    int placedRow[ALL_MOVES], placedCol[ALL_MOVES];
+    placedRow[0] = row;
+    placedCol[0] = col;
+
+    for (int placed = 1; placed < stones; ) {
+        int from = (int)(nextRandom(seed) % placed);
+        int r = placedRow[from] + (int)(nextRandom(seed) % 5) - 2;
+        int c = placedCol[from] + (int)(nextRandom(seed) % 5) - 2;
+        if (r < 0 || r >= BOARD_SIZE || c < 0 || c >= BOARD_SIZE) continue;
+        if (b->board[r][c] != EMPTY) continue;
+
+        b->board[r][c] = (placed % 2 == 0) ? BLACK : WHITE;
+        placedRow[placed] = r;
+        placedCol[placed] = c;
+        placed++;
+    }
+
+    mbFromBoard(b->mb, b->board);
+}
+
+static void buildCorpus(void) {
+    unsigned long long seed = 0x62656E63684F4D4BULL;     // 고정 시드: 실행마다 같은 보드
+    for (int d = 0; d < DENSITY_COUNT; d++) {
+        for (int i = 0; i < CORPUS_BOARDS; i++) {
+            buildBoard(&corpus[d][i], DENSITIES[d], &seed);
+        }
+    }
+}
+
+// ============================================================
+// 참조 구현 (2차원 배열 + 범위 검사, 엔진 최적화 이전 방식)
+// ============================================================
+
+static int inBoard(int row, int col) {
+    return row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE;
+}
+
+static int refCheckWin(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
+    if (board[row][col] != color) return 0;
+
+    for (int dir = 0; dir < 4; dir++) {
+        int count = 1;
+        for (int r = row + DY[dir], c = col + DX[dir];
+             inBoard(r, c) && board[r][c] == color; r += DY[dir], c += DX[dir]) count++;
+        for (int r = row - DY[dir], c = col - DX[dir];
+             inBoard(r, c) && board[r][c] == color; r -= DY[dir], c -= DX[dir]) count++;
+        if (count >= 5) return 1;
+    }
+    return 0;
+}
+
+// (row, col)을 color로 간주하고 dir 방향 연속 수와 열린 끝 수
+static void refAnalyzeLine(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int dir,
+                           int color, int *count, int *openEnds) {
+    int r, c;
+    *count = 1;
+    *openEnds = 0;
+
+    for (r = row + DY[dir], c = col + DX[dir];
+         inBoard(r, c) && board[r][c] == color; r += DY[dir], c += DX[dir]) (*count)++;
+    if (inBoard(r, c) && board[r][c] == EMPTY) (*openEnds)++;
+
+    for (r = row - DY[dir], c = col - DX[dir];
+         inBoard(r, c) && board[r][c] == color; r -= DY[dir], c -= DX[dir]) (*count)++;
+    if (inBoard(r, c) && board[r][c] == EMPTY) (*openEnds)++;
+}
+
+static int refWeight(int row, int col) {
+    int center = BOARD_SIZE / 2;
+    return BOARD_SIZE - abs(row - center) - abs(col - center);
+}
+
+static int refLineScore(int count, int openEnds, int single) {
+    if (count >= 5) return SCORE_FIVE;
+    if (openEnds == 0) return 0;
+    switch (count) {
+        case 4: return (openEnds == 2) ? SCORE_OPEN_FOUR : SCORE_FOUR;
+        case 3: return (openEnds == 2) ? SCORE_OPEN_THREE : SCORE_THREE;
+        case 2: return (openEnds == 2) ? SCORE_OPEN_TWO : SCORE_TWO;
+        default: return single ? SCORE_ONE * openEnds : 0;
+    }
+}
+
+static int refEvaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
+    if (board[row][col] != EMPTY) return 0;
+
+    int score = 0;
+    int fours = 0;
+    int openThrees = 0;
+
+    for (int dir = 0; dir < 4; dir++) {
+        int count, openEnds;
+        refAnalyzeLine(board, row, col, dir, color, &count, &openEnds);
+        score += refLineScore(count, openEnds, 1);
+        if (count == 4 && openEnds == 1) fours++;
+        else if (count == 3 && openEnds == 2) openThrees++;
+    }
+
+    if (fours >= 2) score += SCORE_OPEN_FOUR;
+    if (fours >= 1 && openThrees >= 1) score += SCORE_OPEN_FOUR / 2;
+    if (openThrees >= 2) score += SCORE_FOUR;
+    return score + refWeight(row, col);
+}
+
+static int refEvaluateBoard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
+    int score = 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int color = board[row][col];
+            if (color == EMPTY) continue;
+            int sign = (color == aiColor) ? 1 : -1;
+
+            for (int dir = 0; dir < 4; dir++) {
+                int pr = row - DY[dir], pc = col - DX[dir];
+                if (inBoard(pr, pc) && board[pr][pc] == color) continue;
+
+                int count, openEnds;
+                refAnalyzeLine(board, row, col, dir, color, &count, &openEnds);
+                score += sign * refLineScore(count, openEnds, 0);
+            }
+            score += sign * refWeight(row, col);
+        }
+    }
+    return score;
+}
+
+// 돌 주변 range칸 이내 빈칸 전부 (순서 무관 해시 + 가중치 내림차순 검사용)
+static unsigned long long refNearbyHash(int board[BOARD_SIZE][BOARD_SIZE], int range) {
+    unsigned long long setHash = 0;
+    int count = 0;
+    int hasStone = 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (board[row][col] != EMPTY) {
+                hasStone = 1;
+                continue;
+            }
+            int near = 0;
+            for (int dr = -range; dr <= range && !near; dr++) {
+                for (int dc = -range; dc <= range && !near; dc++) {
+                    int r = row + dr, c = col + dc;
+                    if (inBoard(r, c) && board[r][c] != EMPTY) near = 1;
+                }
+            }
+            if (near) {
+                setHash += cellHash(row, col);
+                count++;
+            }
+        }
+    }
+
+    if (!hasStone) return mixHash(cellHash(BOARD_SIZE / 2, BOARD_SIZE / 2), 1);
+    return mixHash(setHash, count);
+}
+
+static int refFindThreats(int board[BOARD_SIZE][BOARD_SIZE], int color, Move threats[], int maxThreats) {
+    int threatCount = 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (board[row][col] != color) continue;
+
+            for (int dir = 0; dir < 4; dir++) {
+                int pr = row - DY[dir], pc = col - DX[dir];
+                if (inBoard(pr, pc) && board[pr][pc] == color) continue;
+
+                int count = 1;
+                int r = row + DY[dir], c = col + DX[dir];
+                while (inBoard(r, c) && board[r][c] == color) {
+                    count++;
+                    r += DY[dir];
+                    c += DX[dir];
+                }
+                if (count < 3) continue;
+
+                int endRow[2] = {r, pr};
+                int endCol[2] = {c, pc};
+                for (int e = 0; e < 2; e++) {
+                    if (!inBoard(endRow[e], endCol[e]) || board[endRow[e]][endCol[e]] != EMPTY) continue;
+
+                    int duplicate = 0;
+                    for (int t = 0; t < threatCount; t++) {
+                        if (threats[t].row == endRow[e] && threats[t].col == endCol[e]) duplicate = 1;
+                    }
+                    if (duplicate) continue;
+                    if (threatCount == maxThreats) return threatCount;
+                    threats[threatCount].row = endRow[e];
+                    threats[threatCount].col = endCol[e];
+                    threatCount++;
+                }
+            }
+        }
+    }
+    return threatCount;
+}
+
+static int refThreatBlockScore(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int opponent) {
+    if (board[row][col] != EMPTY) return 0;
+
+    int blockScore = 0;
+    for (int dir = 0; dir < 4; dir++) {
+        int total = 0, open = 0;
+        int r, c;
+
+        for (r = row + DY[dir], c = col + DX[dir];
+             inBoard(r, c) && board[r][c] == opponent; r += DY[dir], c += DX[dir]) total++;
+        if (inBoard(r, c) && board[r][c] == EMPTY) open++;
+        for (r = row - DY[dir], c = col - DX[dir];
+             inBoard(r, c) && board[r][c] == opponent; r -= DY[dir], c -= DX[dir]) total++;
+        if (inBoard(r, c) && board[r][c] == EMPTY) open++;
+
+        if (total >= 4) blockScore += SCORE_FIVE;
+        else if (total == 3) blockScore += (open >= 1) ? SCORE_OPEN_FOUR : SCORE_FOUR;
+        else if (total == 2 && open == 2) blockScore += SCORE_OPEN_THREE;
+    }
+    return blockScore;
+}
+
+// ============================================================
+// 커널 실행기: 보드 하나에 대해 커널을 모든 대상 칸/색에 호출하고 출력 해시 반환
+// (참조 실행기는 같은 순서로 같은 값을 섞어야 함)
+// ============================================================
+
+static unsigned long long runCheckWin(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (b->board[row][col] == EMPTY) continue;
+            h = mixHash(h, checkWinBoard(b->board, row, col, b->board[row][col]));
+            (*ops)++;
+        }
+    }
+    return h;
+}
+
+static unsigned long long refRunCheckWin(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (b->board[row][col] == EMPTY) continue;
+            h = mixHash(h, refCheckWin(b->board, row, col, b->board[row][col]));
+            (*ops)++;
+        }
+    }
+    return h;
+}
+
+static unsigned long long runAnalyzeLine(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (b->mb[idx] != EMPTY) continue;
+            for (int color = BLACK; color <= WHITE; color++) {
+                for (int dir = 0; dir < 4; dir++) {
+                    int count, openEnds;
+                    mbAnalyzeLine(b->mb, idx, MB_DIR[dir], color, &count, &openEnds);
+                    h = mixHash(h, count * 3 + openEnds);
+                    (*ops)++;
+                }
+            }
+        }
+    }
+    return h;
+}
+
+static unsigned long long refRunAnalyzeLine(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (b->board[row][col] != EMPTY) continue;
+            for (int color = BLACK; color <= WHITE; color++) {
+                for (int dir = 0; dir < 4; dir++) {
+                    int count, openEnds;
+                    refAnalyzeLine(b->board, row, col, dir, color, &count, &openEnds);
+                    h = mixHash(h, count * 3 + openEnds);
+                    (*ops)++;
+                }
+            }
+        }
+    }
+    return h;
+}
+
+static unsigned long long runEvaluatePosition(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (b->mb[idx] != EMPTY) continue;
+            h = mixHash(h, evaluatePosition(b->mb, idx, BLACK));
+            h = mixHash(h, evaluatePosition(b->mb, idx, WHITE));
+            *ops += 2;
+        }
+    }
+    return h;
+}
+
+static unsigned long long refRunEvaluatePosition(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (b->board[row][col] != EMPTY) continue;
+            h = mixHash(h, refEvaluatePosition(b->board, row, col, BLACK));
+            h = mixHash(h, refEvaluatePosition(b->board, row, col, WHITE));
+            *ops += 2;
+        }
+    }
+    return h;
+}
+
+static unsigned long long runEvaluateBoard(BenchBoard *b, long long *ops) {
+    unsigned long long h = mixHash(HASH_INIT, evaluateBoardMb(b->mb, BLACK));
+    *ops += 2;
+    return mixHash(h, evaluateBoardMb(b->mb, WHITE));
+}
+
+static unsigned long long refRunEvaluateBoard(BenchBoard *b, long long *ops) {
+    unsigned long long h = mixHash(HASH_INIT, refEvaluateBoard(b->board, BLACK));
+    *ops += 2;
+    return mixHash(h, refEvaluateBoard(b->board, WHITE));
+}
+
+// 후보 수 해시: 집합은 순서 무관, 정렬은 가중치가 내림차순인지로 확인
+// (동점끼리의 순서는 qsort 구현에 따라 다를 수 있어 비교하지 않음)
+static unsigned long long movesHash(const Move moves[], int count) {
+    unsigned long long setHash = 0;
+    for (int i = 0; i < count; i++) {
+        setHash += cellHash(moves[i].row, moves[i].col);
+        if (i > 0 && refWeight(moves[i].row, moves[i].col) > refWeight(moves[i - 1].row, moves[i - 1].col)) {
+            return 0;   // 정렬 깨짐: 참조 해시와 절대 같지 않음
+        }
+    }
+    return mixHash(setHash, count);
+}
+
+static unsigned long long runPossibleMoves(BenchBoard *b, long long *ops) {
+    Move moves[ALL_MOVES];
+    int count = getPossibleMoves(b->board, moves, ALL_MOVES);
+    (*ops)++;
+    return movesHash(moves, count);
+}
+
+static unsigned long long refRunPossibleMoves(BenchBoard *b, long long *ops) {
+    (*ops)++;
+    return refNearbyHash(b->board, 2);
+}
+
+static unsigned long long runPossibleMovesHard(BenchBoard *b, long long *ops) {
+    Move moves[ALL_MOVES];
+    int count = getPossibleMovesHard(b->mb, moves, ALL_MOVES);
+    (*ops)++;
+    return movesHash(moves, count);
+}
+
+static unsigned long long refRunPossibleMovesHard(BenchBoard *b, long long *ops) {
+    (*ops)++;
+    return refNearbyHash(b->board, 3);
+}
+
+static unsigned long long threatsHash(unsigned long long h, const Move threats[], int count) {
+    h = mixHash(h, count);
+    for (int t = 0; t < count; t++) {
+        h = mixHash(h, threats[t].row * BOARD_SIZE + threats[t].col);
+    }
+    return h;
+}
+
+static unsigned long long runFindThreats(BenchBoard *b, long long *ops) {
+    Move threats[20];
+    unsigned long long h = HASH_INIT;
+    for (int color = BLACK; color <= WHITE; color++) {
+        h = threatsHash(h, threats, findThreats(b->mb, color, threats, 20));
+        (*ops)++;
+    }
+    return h;
+}
+
+static unsigned long long refRunFindThreats(BenchBoard *b, long long *ops) {
+    Move threats[20];
+    unsigned long long h = HASH_INIT;
+    for (int color = BLACK; color <= WHITE; color++) {
+        h = threatsHash(h, threats, refFindThreats(b->board, color, threats, 20));
+        (*ops)++;
+    }
+    return h;
+}
+
+static unsigned long long runThreatBlock(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (b->mb[idx] != EMPTY) continue;
+            h = mixHash(h, getThreatBlockScore(b->mb, idx, BLACK));
+            h = mixHash(h, getThreatBlockScore(b->mb, idx, WHITE));
+            *ops += 2;
+        }
+    }
+    return h;
+}
+
+static unsigned long long refRunThreatBlock(BenchBoard *b, long long *ops) {
+    unsigned long long h = HASH_INIT;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (b->board[row][col] != EMPTY) continue;
+            h = mixHash(h, refThreatBlockScore(b->board, row, col, BLACK));
+            h = mixHash(h, refThreatBlockScore(b->board, row, col, WHITE));
+            *ops += 2;
+        }
+    }
+    return h;
+}
+
+typedef unsigned long long (*KernelRunner)(BenchBoard *b, long long *ops);
+
+typedef struct {
+    const char *name;
+    KernelRunner run;
+    KernelRunner reference;
+} Kernel;
+
+static const Kernel KERNELS[] = {
+    {"checkWinBoard",        runCheckWin,          refRunCheckWin},
+    {"mbAnalyzeLine",        runAnalyzeLine,       refRunAnalyzeLine},
+    {"evaluatePosition",     runEvaluatePosition,  refRunEvaluatePosition},
+    {"evaluateBoardMb",      runEvaluateBoard,     refRunEvaluateBoard},
+    {"getPossibleMoves",     runPossibleMoves,     refRunPossibleMoves},
+    {"getPossibleMovesHard", runPossibleMovesHard, refRunPossibleMovesHard},
+    {"findThreats",          runFindThreats,       refRunFindThreats},
+    {"getThreatBlockScore",  runThreatBlock,       refRunThreatBlock},
+};
+#define KERNEL_COUNT ((int)(sizeof(KERNELS) / sizeof(KERNELS[0])))
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// 보드 모음 전체를 한 번 도는 시간 (ns)
+static long long timePass(KernelRunner run, int density, unsigned long long *sink) {
+    long long ops = 0;
+    long long start = nowNs();
+    for (int i = 0; i < CORPUS_BOARDS; i++) {
+        *sink ^= run(&corpus[density][i], &ops);
+    }
+    return nowNs() - start;
+}
+
+// ============================================================
+// 금수 판정 사례 (띈 3/띈 4 포함). 그림은 보드 가운데 9x9, X 흑, O 백, * 판정 칸
+// ============================================================
+
+typedef struct {
+    const char *name;
+    const char *rows[9];
+    int expected;
+} ForbidCase;
+
+static const ForbidCase FORBID_CASES[] = {
+    {"연속 3 + 연속 3", {".........", ".........", "....X....", "....X....", "..XX*....",
+                          ".........", ".........", ".........", "........."}, FORBID_33},
+    {"띈 3 + 연속 3", {".........", ".........", "....X....", "....X....", "..X.*X...",
+                        ".........", ".........", ".........", "........."}, FORBID_33},
+    {"띈 4 + 띈 4", {"....X....", "....X....", "....X....", ".........", "X.XX*....",
+                      ".........", ".........", ".........", "........."}, FORBID_44},
+    {"한 줄 쌍사 X.XXX.X", {".........", ".........", ".........", ".........", "X.XX*.X..",
+                             ".........", ".........", ".........", "........."}, FORBID_44},
+    {"한 줄 쌍사 XX.XX.XX", {".........", ".........", ".........", ".........", "XX.X*.XX.",
+                              ".........", ".........", ".........", "........."}, FORBID_44},
+    {"4 + 3은 허용", {".........", ".........", "....X....", "....X....", "XXX.*....",
+                       ".........", ".........", ".........", "........."}, 0},
+    {"막힌 띈 3은 3 아님", {".........", ".........", "....X....", "....X....", "..OX*.X..",
+                            ".........", ".........", ".........", "........."}, 0},
+    {"띈 3이 장목 쪽으로만 열림", {".........", ".........", "....X....", "....X....", "X.X.*X...",
+                                  ".........", ".........", ".........", "........."}, 0},
+    {"5목은 금수보다 우선", {"....X....", "....X....", "....X....", ".........", "XXXX*....",
+                             ".........", ".........", ".........", "........."}, 0},
+    {"장목", {".........", ".........", ".........", ".........", "XXX*XX...",
+               ".........", ".........", ".........", "........."}, FORBID_OVERLINE},
+};
+#define FORBID_CASE_COUNT ((int)(sizeof(FORBID_CASES) / sizeof(FORBID_CASES[0])))
+
+// 사례마다 forbidCheckCell 결과 비교. 틀린 사례 수 반환
+static int checkForbidCases(void) {
+    int failures = 0;
+
+    for (int c = 0; c < FORBID_CASE_COUNT; c++) {
+        const ForbidCase *fc = &FORBID_CASES[c];
+        unsigned char mb[MB_CELLS];
+        int target = -1;
+
+        mbInit(mb);
+        for (int r = 0; r < 9; r++) {
+            for (int col = 0; col < 9; col++) {
+                int idx = MB_INDEX(BOARD_SIZE / 2 - 4 + r, BOARD_SIZE / 2 - 4 + col);
+                char ch = fc->rows[r][col];
+                if (ch == 'X') mb[idx] = BLACK;
+                else if (ch == 'O') mb[idx] = WHITE;
+                else if (ch == '*') target = idx;
+            }
+        }
+
+        int got = forbidCheckCell(mb, target, BLACK, FORBID_RENJU);
+        if (got != fc->expected) {
+            printf("금수 판정 불일치: %s (기대 %d, 결과 %d)\n", fc->name, fc->expected, got);
+            failures++;
+        }
+    }
+    printf("금수 판정 사례: %d/%d 일치\n\n", FORBID_CASE_COUNT - failures, FORBID_CASE_COUNT);
+    return failures;
+}
+
+// ============================================================
+// 프런티어 전술 사례: 남은 깊이 1, 2의 전방 가지치기가 강제 승리/필수 방어를 가리지 않는지.
+// 흑 차례로 minimax를 돌려, 필승 사례는 승리 점수를, 방어 사례는 고른 수가 * 칸(정적으로는 좋아
+// 보이지만 백에게 강제 승리를 주는 수)이 아니고 그 뒤 백이 강제 승리를 찾지 못하는지 확인한다
+// (그림 규칙은 금수 사례와 같음)
+// ============================================================
+
+typedef struct {
+    const char *name;
+    const char *rows[9];
+    int depth;
+    int expectWin;      // 1 필승 (점수가 승리), 0 방어 (고른 수가 지지 않음)
+} FrontierCase;
+
+static const FrontierCase FRONTIER_CASES[] = {
+    {"프런티어 필승", {"...X.....", "XO..O....", "...X.....", ".O...OO.O", "....X...X",
+                        "......O.X", "....X....", ".......O.", "X....X.OX"}, 4, 1},
+    {"프런티어 방어 1", {"XX.....O.", "....X...X", ".XO..O...", "X......O.", "....X....",
+                          ".O.*O..OO", "..X..X...", "....O..X.", "...OO.X.X"}, 4, 0},
+    {"프런티어 방어 2", {"......OX.", ".O......X", "......O.X", "..XXO....", "O.....O.O",
+                          "...OX....", "..O.*...X", "O..X.....", "..X...X.."}, 4, 0},
+};
+#define FRONTIER_CASE_COUNT ((int)(sizeof(FRONTIER_CASES) / sizeof(FRONTIER_CASES[0])))
+
+static int checkFrontierCases(void) {
+    int failures = 0;
+
+    for (int c = 0; c < FRONTIER_CASE_COUNT; c++) {
+        const FrontierCase *fc = &FRONTIER_CASES[c];
+        int board[BOARD_SIZE][BOARD_SIZE] = {{0}};
+        int trapRow = -1, trapCol = -1;
+
+        for (int r = 0; r < 9; r++) {
+            for (int col = 0; col < 9; col++) {
+                int row = BOARD_SIZE / 2 - 4 + r, column = BOARD_SIZE / 2 - 4 + col;
+                char ch = fc->rows[r][col];
+                if (ch == 'X') board[row][column] = BLACK;
+                else if (ch == 'O') board[row][column] = WHITE;
+                else if (ch == '*') { trapRow = row; trapCol = column; }
+            }
+        }
+
+        MoveResult best = minimax(board, fc->depth, -INFINITY_SCORE, INFINITY_SCORE, 1, BLACK);
+        int ok;
+        if (fc->expectWin) {
+            ok = best.score >= INFINITY_SCORE - 100;
+        } else if (best.row == trapRow && best.col == trapCol) {
+            ok = 0;
+        } else {
+            board[best.row][best.col] = BLACK;
+            MoveResult reply = minimax(board, fc->depth - 1, -INFINITY_SCORE, INFINITY_SCORE, 0, BLACK);
+            ok = reply.score > -INFINITY_SCORE + 100;
+        }
+        if (!ok) {
+            printf("프런티어 전술 불일치: %s (수 %d,%d 점수 %d)\n", fc->name, best.row, best.col, best.score);
+            failures++;
+        }
+    }
+    printf("프런티어 전술 사례: %d/%d 일치\n\n", FRONTIER_CASE_COUNT - failures, FRONTIER_CASE_COUNT);
+    return failures;
+}
+
+// 커널 하나, 밀도 하나: 결과 해시 비교 후 반복 측정. 불일치면 0 반환
+static int benchKernel(const Kernel *k, int density, int reps) {
+    static double perOp[MAX_REPS];
+    unsigned long long hash = HASH_INIT, refHash = HASH_INIT, sink = 0;
+    long long ops = 0, refOps = 0;
+
+    for (int i = 0; i < CORPUS_BOARDS; i++) {
+        hash = mixHash(hash, (long long)k->run(&corpus[density][i], &ops));
+        refHash = mixHash(refHash, (long long)k->reference(&corpus[density][i], &refOps));
+    }
+    int match = (hash == refHash && ops == refOps);
+
+    for (int r = 0; r < WARMUP_REPS; r++) {
+        timePass(k->run, density, &sink);
+    }
+    for (int r = 0; r < reps; r++) {
+        perOp[r] = (double)timePass(k->run, density, &sink) / ops;
+    }
+    qsort(perOp, reps, sizeof(double), compareDouble);
+
+    double median = perOp[reps / 2];
+    double p99 = perOp[(reps * 99) / 100 < reps ? (reps * 99) / 100 : reps - 1];
+
+    printf("%-22s %5d %9lld %10.1f %10.1f  %016llx  %s\n",
+           k->name, DENSITIES[density], ops, median, p99, hash,
+           match ? "OK" : "MISMATCH");
+
+    // sink를 써서 컴파일러가 측정 루프를 지우지 못하게 함
+    if (sink == 0x5EED) printf("\n");
+    return match;
+}
+
+int main(int argc, char *argv[]) {
+    int reps = (argc > 1) ? atoi(argv[1]) : DEFAULT_REPS;
+    const char *filter = (argc > 2) ? argv[2] : NULL;
+
+    if (reps < 1) reps = 1;
+    if (reps > MAX_REPS) reps = MAX_REPS;
+
+    initAI();
+    buildCorpus();
+
+    printf("커널 마이크로벤치마크: 밀도당 보드 %d개, 예열 %d회, 측정 %d회\n",
+           CORPUS_BOARDS, WARMUP_REPS, reps);
+    printf("%-22s %5s %9s %10s %10s  %-16s  %s\n",
+           "커널", "돌 수", "호출/회", "중앙 ns", "p99 ns", "출력 해시", "참조 비교");
+
+    int mismatches = checkForbidCases();
+    mismatches += checkFrontierCases();
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (filter && !strstr(KERNELS[k].name, filter)) continue;
+        for (int d = 0; d < DENSITY_COUNT; d++) {
+            if (!benchKernel(&KERNELS[k], d, reps)) mismatches++;
+        }
+    }
+
+    if (mismatches > 0) {
+        printf("\n참조 구현과 다른 결과: %d건\n", mismatches);
+    }
+
+    cleanupAI();
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// 비트보드 위협 맵 (방향별 시프트로 모든 빈칸의 라인 패턴을 한꺼번에 분류)
+
+#include "bitboard.h"
+#include "mailbox.h"
+
+static inline Bitboard bbAnd(Bitboard a, Bitboard b) {
+    for (int i = 0; i < BB_WORDS; i++) a.w[i] &= b.w[i];
+    return a;
+}
+
+static inline Bitboard bbAndNot(Bitboard a, Bitboard b) {
+    for (int i = 0; i < BB_WORDS; i++) a.w[i] &= ~b.w[i];
+    return a;
+}
+
+static inline void bbOrInto(Bitboard *a, Bitboard b) {
+    for (int i = 0; i < BB_WORDS; i++) a->w[i] |= b.w[i];
+}
+
+// 비트 p를 p - n으로 (칸 x에 x + n 칸의 값을 가져옴, 0 < n < 64)
+static inline Bitboard bbDown(Bitboard a, int n) {
+    Bitboard r;
+    for (int i = 0; i < BB_WORDS - 1; i++) r.w[i] = (a.w[i] >> n) | (a.w[i + 1] << (64 - n));
+    r.w[BB_WORDS - 1] = a.w[BB_WORDS - 1] >> n;
+    return r;
+}
+
+// 비트 p를 p + n으로 (칸 x에 x - n 칸의 값을 가져옴)
+static inline Bitboard bbUp(Bitboard a, int n) {
+    Bitboard r;
+    for (int i = BB_WORDS - 1; i > 0; i--) r.w[i] = (a.w[i] << n) | (a.w[i - 1] >> (64 - n));
+    r.w[0] = a.w[0] << n;
+    return r;
+}
+
+// 한 방향의 라인 패턴을 분류해 map에 누적 (d를 상수로 인라인해 시프트가 즉시값이 되게)
+static inline void classifyDirection(Bitboard stones, Bitboard empty, int d,
+                                     ThreatMap *map, Bitboard *doubleFour) {
+    // ahead[k]: x+d..x+kd가 모두 내 돌, aheadOpen[k]: 그 다음 칸이 빈칸 (behind는 반대쪽)
+    Bitboard ahead[5], behind[5], aheadOpen[4], behindOpen[4];
+
+    for (int i = 0; i < BB_WORDS; i++) ahead[0].w[i] = ~0ULL;
+    behind[0] = ahead[0];
+    for (int k = 1; k <= 4; k++) {
+        ahead[k] = bbDown(bbAnd(stones, ahead[k - 1]), d);
+        behind[k] = bbUp(bbAnd(stones, behind[k - 1]), d);
+    }
+    aheadOpen[0] = bbDown(empty, d);
+    behindOpen[0] = bbUp(empty, d);
+    for (int k = 1; k <= 3; k++) {
+        aheadOpen[k] = bbDown(bbAnd(stones, aheadOpen[k - 1]), d);
+        behindOpen[k] = bbUp(bbAnd(stones, behindOpen[k - 1]), d);
+    }
+
+    // 연속 5 이상: 앞 a + 뒤 (4 - a)
+    for (int a = 0; a <= 4; a++) bbOrInto(&map->five, bbAnd(ahead[a], behind[4 - a]));
+
+    // 연속 정확히 4: 앞 a, 뒤 3 - a (끝이 열렸는지 방향별로)
+    Bitboard count4 = {{0}}, openAhead = {{0}}, openBehind = {{0}};
+    for (int a = 0; a <= 3; a++) {
+        Bitboard exactAhead = bbAndNot(ahead[a], ahead[a + 1]);
+        Bitboard exactBehind = bbAndNot(behind[3 - a], behind[4 - a]);
+        bbOrInto(&count4, bbAnd(exactAhead, exactBehind));
+        bbOrInto(&openAhead, bbAnd(aheadOpen[a], exactBehind));
+        bbOrInto(&openBehind, bbAnd(exactAhead, behindOpen[3 - a]));
+    }
+    for (int i = 0; i < BB_WORDS; i++) {
+        unsigned long long oneOpen = count4.w[i] & (openAhead.w[i] ^ openBehind.w[i]);
+        map->openFour.w[i] |= openAhead.w[i] & openBehind.w[i];
+        doubleFour->w[i] |= map->four.w[i] & oneOpen;
+        map->four.w[i] |= oneOpen;
+    }
+
+    // 양쪽 열린 연속 3
+    for (int a = 0; a <= 2; a++) bbOrInto(&map->openThree, bbAnd(aheadOpen[a], behindOpen[2 - a]));
+}
+
+void bbThreatMap(const unsigned char *mb, int color, ThreatMap *map) {
+    Bitboard stones = {{0}};
+    Bitboard empty = {{0}};
+    Bitboard doubleFour = {{0}};
+
+    // 한 줄씩 모음 (분기 없이). 15x15는 워드 하나에 정확히 4줄, 19x19는 줄이 워드 경계에 걸침
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        const unsigned char *p = mb + MB_INDEX(row, 0);
+        unsigned long long own = 0, vacant = 0;
+        for (int col = 0; col < MB_BOARD_SIZE; col++) {
+            own |= (unsigned long long)(p[col] == color) << col;
+            vacant |= (unsigned long long)(p[col] == MB_EMPTY) << col;
+        }
+        int bit = row * BB_STRIDE;
+        int word = bit >> 6;
+        int shift = bit & 63;
+        stones.w[word] |= own << shift;
+        empty.w[word] |= vacant << shift;
+        if (shift + BB_STRIDE > 64) {
+            stones.w[word + 1] |= own >> (64 - shift);
+            empty.w[word + 1] |= vacant >> (64 - shift);
+        }
+    }
+
+    *map = (ThreatMap){{{0}}};
+    classifyDirection(stones, empty, 1, map, &doubleFour);                // 가로
+    classifyDirection(stones, empty, BB_STRIDE, map, &doubleFour);        // 세로
+    classifyDirection(stones, empty, BB_STRIDE + 1, map, &doubleFour);    // 대각선
+    classifyDirection(stones, empty, BB_STRIDE - 1, map, &doubleFour);    // 역대각선
+
+    for (int i = 0; i < BB_WORDS; i++) {
+        map->five.w[i] &= empty.w[i];
+        map->four.w[i] &= empty.w[i];
+        map->openFour.w[i] &= empty.w[i];
+        map->openThree.w[i] &= empty.w[i];
+        map->win.w[i] = map->five.w[i] | map->openFour.w[i] | (doubleFour.w[i] & empty.w[i]);
+    }
+}
@@ -0,0 +1,45 @@
+// 비트보드 위협 맵 헤더 (보드 전체의 5목/4목/열린3 자리를 한 번에 계산)
+//
+// 15x15 보드를 한 줄 16비트(열 15는 항상 0인 보호 열)로 256비트에 담는다
+// (19x19 빌드는 한 줄 20비트, 384비트). 보호 열 덕분에 가로/대각선 시프트가
+// 다음 줄로 넘어가지 않는다.
+// 색 하나의 돌/빈칸 비트보드를 방향별로 시프트하고 AND/OR해서, 모든 빈칸에 대해
+// "그 칸에 color를 둔다면" 생기는 mbAnalyzeLine 결과(연속 수, 열린 끝)를 분류한다.
+// 결과는 pattern.h의 PAT_CODE와 같은 기준이라 evaluatePosition의 임계값 판정을
+// 칸마다 점수를 매기지 않고 비트 검사로 바꿀 수 있다.
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "mailbox.h"
+
+#define BB_STRIDE (MB_BOARD_SIZE + 1)
+#define BB_WORDS ((MB_BOARD_SIZE * BB_STRIDE + 63) / 64)
+
+typedef struct {
+    unsigned long long w[BB_WORDS];
+} Bitboard;
+
+typedef struct {
+    Bitboard five;          // 5목 이상 (PAT_FIVE)
+    Bitboard four;          // 한쪽만 열린 4 (PAT_CODE(4, 1))
+    Bitboard openFour;      // 양쪽 열린 4 (PAT_CODE(4, 2))
+    Bitboard openThree;     // 양쪽 열린 3 (PAT_CODE(3, 2))
+    Bitboard win;           // 5목, 열린 4, 쌍사 (evaluatePosition >= SCORE_OPEN_FOUR와 같음)
+} ThreatMap;
+
+// 메일박스 mb에서 color의 위협 맵 계산 (빈칸만 켜짐)
+void bbThreatMap(const unsigned char *mb, int color, ThreatMap *map);
+
+static inline int bbTest(const Bitboard *b, int row, int col) {
+    int bit = row * BB_STRIDE + col;
+    return (int)((b->w[bit >> 6] >> (bit & 63)) & 1);
+}
+
+static inline int bbEmpty(const Bitboard *b) {
+    unsigned long long any = 0;
+    for (int i = 0; i < BB_WORDS; i++) any |= b->w[i];
+    return any == 0;
+}
+
+#endif
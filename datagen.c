@@ -0,0 +1,337 @@
+// 학습 데이터 생성 도구: 여러 스레드로 자가 대국을 두며 국면마다 탐색 점수와 최선 수를
+// 기록하고, 대국이 끝나면 결과를 붙여 고정 크기 레코드(posrec.h)로 샤드 파일에 쓴다.
+// 같은 국면(회전/반전 포함)은 정규 해시로 한 번만 쓴다.
+//
+// 사용법: ./omok_datagen [-n 국면 수] [-t 스레드 수] [-b 국면당 ms] [-r 무작위 개국 수]
+//                        [-s 샤드당 레코드 수] [-o 출력 접두사] [-seed 시드] [-renju]
+//         ./omok_datagen -read 샤드.bin ...     (샤드 확인: 레코드 수, 결과 분포)
+// -b 0(기본)이면 국면마다 고정 깊이(분석 도구와 같은 findBestMoves)라 가장 빠르다.
+// 대국마다 처음 -r수는 중앙 근처 무작위 착수라 개국이 갈린다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "ai_internal.h"
+#include "forbid.h"
+#include "timeman.h"
+#include "posrec.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#define MAX_THREADS 64
+#define OPENING_RADIUS 3            // 무작위 개국 수는 중앙에서 이 거리 안
+#define REPORT_INTERVAL_MS 10000
+#define SEEN_MAX_BITS 26            // 중복 확인 표 상한 (2^26개, 512MB)
+
+static long long targetPositions = 100000;
+static int budgetMs = 0;
+static int randomPlies = 4;
+static unsigned long long baseSeed = 1;
+
+// 출력과 중복 확인 (outputLock)
+static pthread_mutex_t outputLock = PTHREAD_MUTEX_INITIALIZER;
+static PosWriter writer;
+static int writeFailed = 0;
+static int finished = 0;
+static long long gamesDone = 0;
+static long long duplicates = 0;
+static long long resultCount[3];    // 쓴 레코드의 대국 결과 (EMPTY/BLACK/WHITE)
+static long long startMs = 0;
+static long long lastReportMs = 0;
+
+// 정규 키 열린 주소 표 (0 = 빈 칸). 3/4가 차면 더 넣지 않고 그 뒤로는 중복 확인 없이 씀
+static unsigned long long *seen = NULL;
+static long long seenMask = 0;
+static long long seenCount = 0;
+
+static int onlineCores(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+static int opponentOf(int color) {
+    return (color == BLACK) ? WHITE : BLACK;
+}
+
+static unsigned long long nextRandom(unsigned long long *state) {
+    unsigned long long x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// ============================================================
+// 중복 확인
+// ============================================================
+
+static int allocSeen(long long target) {
+    int bits = 16;
+    while (bits < SEEN_MAX_BITS && (1LL << bits) < target * 2) bits++;
+    seen = (unsigned long long*)calloc((size_t)1 << bits, sizeof(unsigned long long));
+    seenMask = (1LL << bits) - 1;
+    return seen != NULL;
+}
+
+// 처음 보는 키면 1 (표가 가득 차면 항상 1)
+static int markSeen(unsigned long long key) {
+    long long i = (long long)(key & (unsigned long long)seenMask);
+    while (seen[i] != 0) {
+        if (seen[i] == key) return 0;
+        i = (i + 1) & seenMask;
+    }
+    if (seenCount + 1 > (seenMask + 1) / 4 * 3) return 1;
+    seen[i] = key;
+    seenCount++;
+    return 1;
+}
+
+// ============================================================
+// 자가 대국
+// ============================================================
+
+// 중앙 근처 빈칸에 무작위로 (이미 5목이 생기는 수는 피함)
+static void playRandomOpening(int board[BOARD_SIZE][BOARD_SIZE], int *color, unsigned long long *rng) {
+    int center = BOARD_SIZE / 2;
+    int span = 2 * OPENING_RADIUS + 1;
+
+    for (int ply = 0; ply < randomPlies; ply++) {
+        for (int tries = 0; tries < 64; tries++) {
+            int row = center - OPENING_RADIUS + (int)(nextRandom(rng) % span);
+            int col = center - OPENING_RADIUS + (int)(nextRandom(rng) % span);
+            if (board[row][col] != EMPTY) continue;
+            board[row][col] = *color;
+            if (checkWinBoard(board, row, col, *color)) {
+                board[row][col] = EMPTY;
+                continue;
+            }
+            break;
+        }
+        *color = opponentOf(*color);
+    }
+}
+
+// 한 판 두고 국면 기록을 records에 채움. 반환값은 기록한 국면 수, *winner는 승자 색
+static int playGame(PosRecord records[], unsigned long long *rng, int *winner) {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int color = BLACK;
+    int count = 0;
+
+    memset(board, 0, sizeof(board));
+    playRandomOpening(board, &color, rng);
+    *winner = EMPTY;
+
+    while (count < BOARD_SIZE * BOARD_SIZE) {
+        PvLine line;
+        if (findBestMoves(board, color, 1, budgetMs, &line) <= 0) break;    // 둘 곳 없음 (무승부)
+
+        PosRecord *r = &records[count++];
+        memcpy(r->board, board, sizeof(board));
+        r->toMove = color;
+        r->score = line.score;
+        r->best = line.move;
+
+        board[line.move.row][line.move.col] = color;
+        if (checkWinBoard(board, line.move.row, line.move.col, color)) {
+            *winner = color;
+            break;
+        }
+        color = opponentOf(color);
+    }
+    return count;
+}
+
+static void printProgress(long long now) {
+    double seconds = (now - startMs) / 1000.0;
+    fprintf(stderr, "  대국 %lld, 국면 %lld (중복 %lld), %.0f 국면/시간\n",
+            gamesDone, writer.written, duplicates,
+            seconds > 0 ? writer.written * 3600.0 / seconds : 0.0);
+}
+
+// 대국 하나의 기록을 결과와 함께 씀. 목표에 닿으면 finished
+static void flushGame(PosRecord records[], int count, int winner) {
+    pthread_mutex_lock(&outputLock);
+    if (!finished) {
+        gamesDone++;
+        for (int i = 0; i < count && writer.written < targetPositions; i++) {
+            records[i].result = winner;
+            if (!markSeen(posrecKey(&records[i]))) {
+                duplicates++;
+                continue;
+            }
+            if (!posWriterPut(&writer, &records[i])) {
+                writeFailed = 1;
+                break;
+            }
+            resultCount[winner]++;
+        }
+        if (writeFailed || writer.written >= targetPositions) finished = 1;
+
+        long long now = tmNowMs();
+        if (now - lastReportMs >= REPORT_INTERVAL_MS) {
+            lastReportMs = now;
+            printProgress(now);
+        }
+    }
+    pthread_mutex_unlock(&outputLock);
+}
+
+static void *generateWorker(void *arg) {
+    int index = (int)(long)arg;
+    unsigned long long rng = baseSeed * 0x9E3779B97F4A7C15ULL + (unsigned long long)(index + 1) * 0xD1B54A32D192ED03ULL;
+    PosRecord *records = (PosRecord*)malloc(sizeof(PosRecord) * BOARD_SIZE * BOARD_SIZE);
+
+    if (rng == 0) rng = 1;
+    while (records != NULL) {
+        pthread_mutex_lock(&outputLock);
+        int stop = finished;
+        pthread_mutex_unlock(&outputLock);
+        if (stop) break;
+
+        int winner;
+        int count = playGame(records, &rng, &winner);
+        flushGame(records, count, winner);
+    }
+
+    free(records);
+    cleanupSearchThread();
+    return NULL;
+}
+
+// ============================================================
+// 샤드 확인 (-read)
+// ============================================================
+
+static int readShards(int argc, char *argv[], int first) {
+    PosRecord record;
+    long long total = 0, plies = 0, withMove = 0;
+    long long results[3] = {0, 0, 0};
+    int failed = 0;
+
+    for (int i = first; i < argc; i++) {
+        PosReader reader;
+        if (!posReaderOpen(&reader, argv[i])) {
+            fprintf(stderr, "%s: 국면 레코드 파일이 아님 (보드 크기 %d 빌드)\n", argv[i], BOARD_SIZE);
+            failed = 1;
+            continue;
+        }
+        while (posReaderNext(&reader, &record)) {
+            total++;
+            plies += record.ply;
+            results[record.result]++;
+            if (record.best.row >= 0) withMove++;
+        }
+        if (reader.corrupt) fprintf(stderr, "%s: 잘못된 레코드를 건너뜀\n", argv[i]);
+        printf("%s: 레코드 %lld개\n", argv[i], reader.read);
+        posReaderClose(&reader);
+    }
+
+    printf("합계 %lld개 (레코드 %d바이트), 평균 돌 수 %.1f, 최선 수 있음 %lld\n",
+           total, POSREC_SIZE, total > 0 ? (double)plies / total : 0.0, withMove);
+    printf("결과: 흑 승 %lld, 백 승 %lld, 무승부 %lld\n", results[BLACK], results[WHITE], results[EMPTY]);
+    return failed;
+}
+
+static void printUsage(void) {
+    fprintf(stderr, "사용법: ./omok_datagen [-n 국면 수] [-t 스레드 수] [-b 국면당 ms] [-r 무작위 개국 수]\n");
+    fprintf(stderr, "                       [-s 샤드당 레코드 수] [-o 출력 접두사] [-seed 시드] [-renju]\n");
+    fprintf(stderr, "       ./omok_datagen -read 샤드.bin ...\n");
+    fprintf(stderr, "  출력: 접두사_0000.bin ... (헤더 %d바이트 + 국면당 %d바이트 레코드)\n",
+            POSREC_HEADER_SIZE, POSREC_SIZE);
+}
+
+int main(int argc, char *argv[]) {
+    int threads = onlineCores();
+    long long perShard = 1000000;
+    const char *prefix = "omok_data";
+    int rules = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-read") == 0) {
+            if (i + 1 >= argc) {
+                printUsage();
+                return 1;
+            }
+            return readShards(argc, argv, i + 1);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            targetPositions = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            budgetMs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            randomPlies = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            perShard = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc) {
+            baseSeed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-renju") == 0) {
+            rules = FORBID_RENJU;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (targetPositions < 1) targetPositions = 1;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (budgetMs < 0) budgetMs = 0;
+    if (randomPlies < 0) randomPlies = 0;
+    if (randomPlies > (2 * OPENING_RADIUS + 1) * (2 * OPENING_RADIUS + 1) / 2) {
+        randomPlies = (2 * OPENING_RADIUS + 1) * (2 * OPENING_RADIUS + 1) / 2;
+    }
+
+    if (!allocSeen(targetPositions)) {
+        fprintf(stderr, "메모리가 부족합니다\n");
+        return 1;
+    }
+    if (!posWriterOpen(&writer, prefix, perShard)) {
+        fprintf(stderr, "%s_0000.bin: 쓸 수 없음\n", prefix);
+        return 1;
+    }
+    fprintf(stderr, "목표 국면 %lld개, 스레드 %d개, %s, 무작위 개국 %d수%s\n",
+            targetPositions, threads, budgetMs > 0 ? "시간 예산" : "고정 깊이", randomPlies,
+            rules ? ", 렌주" : "");
+
+    initAI();
+    setForbiddenRules(rules);
+    posrecKey(&(PosRecord){0});     // 키 표를 작업 스레드보다 먼저 만듦
+    startMs = lastReportMs = tmNowMs();
+
+    pthread_t workers[MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, generateWorker, (void*)(long)t) != 0) break;
+        started++;
+    }
+    if (started == 0) generateWorker(NULL);
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    long long elapsed = tmNowMs() - startMs;
+    posWriterClose(&writer);
+    printProgress(tmNowMs());
+    fprintf(stderr, "완료: 샤드 %d개, %.1f초, 결과 흑 %lld / 백 %lld / 무 %lld%s\n",
+            writer.shard + 1, elapsed / 1000.0,
+            resultCount[BLACK], resultCount[WHITE], resultCount[EMPTY],
+            writeFailed ? " (쓰기 실패로 중단)" : "");
+
+    free(seen);
+    cleanupAI();
+    return writeFailed ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// 금수 위치 맵 (엔진, 서버 공용)
+
+#include <string.h>
+#include "forbid.h"
+
+#define FORBID_RANGE 5
+#define LINE_LEN (2 * FORBID_RANGE + 1)     // 판정 칸 양쪽 FORBID_RANGE칸 (가운데 = FORBID_RANGE)
+
+// line[i]를 지나는 color 연속 수 (배열 끝에서 멈춤)
+static int runLength(const unsigned char *line, int i, int color) {
+    int count = 1;
+    for (int p = i + 1; p < LINE_LEN && line[p] == color; p++) count++;
+    for (int p = i - 1; p >= 0 && line[p] == color; p--) count++;
+    return count;
+}
+
+// 빈칸 e에 두면 가운데 돌을 포함해 정확히 5목이 되는지
+// (가운데를 포함한 정확히 5연속은 가운데 ±4칸 안이고 양옆 칸도 배열 안이라 배열 끝이 결과를 바꾸지 않음)
+static int makesFive(unsigned char *line, int e, int color) {
+    const int center = FORBID_RANGE;
+    int lo = e < center ? e : center;
+    int hi = e > center ? e : center;
+
+    if (line[e] != MB_EMPTY) return 0;
+    for (int p = lo; p <= hi; p++) {
+        if (p != e && line[p] != color) return 0;
+    }
+    line[e] = (unsigned char)color;
+    int five = runLength(line, e, color) == 5;
+    line[e] = MB_EMPTY;
+    return five;
+}
+
+// 가운데 돌을 포함한 4 개수 (한 방향에서 0~2). 5목을 만드는 빈칸이 정확히 5칸 떨어진 둘이면
+// 같은 연속 4의 양 끝(열린 4)이라 하나로 센다. 그 밖의 두 자리(X.XXX.X, XX.XX.XX)는 4가 둘
+static int countFours(unsigned char *line, int color, int *straight) {
+    int points[LINE_LEN];
+    int n = 0;
+
+    for (int e = FORBID_RANGE - 4; e <= FORBID_RANGE + 4; e++) {
+        if (makesFive(line, e, color)) points[n++] = e;
+    }
+    *straight = (n == 2 && points[1] - points[0] == 5);
+    if (*straight) return 1;
+    return n > 2 ? 2 : n;
+}
+
+// 빈칸 하나를 더 두어 가운데 돌을 포함한 열린 4(.XXXX.)가 되면 열린 3 (띈 3 .X.XX. 포함)
+// 한 단계만 본다: 그 빈칸이 다시 금수인지는 따지지 않는다.
+static int isOpenThree(unsigned char *line, int color) {
+    for (int e = FORBID_RANGE - 4; e <= FORBID_RANGE + 4; e++) {
+        if (line[e] != MB_EMPTY) continue;
+
+        int straight;
+        line[e] = (unsigned char)color;
+        countFours(line, color, &straight);
+        line[e] = MB_EMPTY;
+        if (straight) return 1;
+    }
+    return 0;
+}
+
+int forbidCheckCell(const unsigned char *mb, int idx, int color, int rules) {
+    int threes = 0;
+    int fours = 0;
+    int overline = 0;
+
+    if (mb[idx] != MB_EMPTY || rules == 0) return 0;
+
+    for (int dir = 0; dir < 4; dir++) {
+        int d = MB_DIR[dir];
+        unsigned char line[LINE_LEN];
+
+        // 가운데 기준 ±FORBID_RANGE칸 (벽 너머는 벽으로 채움)
+        line[FORBID_RANGE] = (unsigned char)color;
+        for (int k = 1, p = idx + d; k <= FORBID_RANGE; k++) {
+            line[FORBID_RANGE + k] = mb[p];
+            if (mb[p] != MB_WALL) p += d;
+        }
+        for (int k = 1, p = idx - d; k <= FORBID_RANGE; k++) {
+            line[FORBID_RANGE - k] = mb[p];
+            if (mb[p] != MB_WALL) p -= d;
+        }
+
+        int count = runLength(line, FORBID_RANGE, color);
+        if (count == 5) return 0;       // 5목 완성은 금수보다 우선
+        if (count >= 6) {
+            overline = 1;
+            continue;
+        }
+
+        int straight;
+        int lineFours = countFours(line, color, &straight);
+        if (lineFours > 0) fours += lineFours;
+        else if (isOpenThree(line, color)) threes++;
+    }
+
+    int result = 0;
+    if ((rules & FORBID_OVERLINE) && overline) result |= FORBID_OVERLINE;
+    if ((rules & FORBID_44) && fours >= 2) result |= FORBID_44;
+    if ((rules & FORBID_33) && threes >= 2) result |= FORBID_33;
+    return result;
+}
+
+static void setCell(ForbidMap *fm, const unsigned char *mb, int idx) {
+    int bit = MB_ROW(idx) * MB_BOARD_SIZE + MB_COL(idx);
+    unsigned int mask = 1u << (bit & 31);
+
+    if (forbidCheckCell(mb, idx, fm->color, fm->rules)) {
+        fm->bits[bit >> 5] |= mask;
+    } else {
+        fm->bits[bit >> 5] &= ~mask;
+    }
+}
+
+void forbidInit(ForbidMap *fm, int color, int rules) {
+    memset(fm->bits, 0, sizeof(fm->bits));
+    fm->color = color;
+    fm->rules = rules;
+}
+
+void forbidRebuild(ForbidMap *fm, const unsigned char *mb) {
+    memset(fm->bits, 0, sizeof(fm->bits));
+    if (fm->rules == 0) return;
+
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        for (int col = 0; col < MB_BOARD_SIZE; col++) {
+            setCell(fm, mb, MB_INDEX(row, col));
+        }
+    }
+}
+
+// 착수/무르기 모두 같은 방식: 변경 칸과 4개 라인 위 ±5칸 재판정 (벽에서 멈춤)
+void forbidUpdate(ForbidMap *fm, const unsigned char *mb, int idx) {
+    if (fm->rules == 0) return;
+
+    setCell(fm, mb, idx);
+    for (int dir = 0; dir < 4; dir++) {
+        int d = MB_DIR[dir];
+        int p = idx + d;
+        for (int k = 0; k < FORBID_RANGE && mb[p] != MB_WALL; k++, p += d) {
+            setCell(fm, mb, p);
+        }
+        p = idx - d;
+        for (int k = 0; k < FORBID_RANGE && mb[p] != MB_WALL; k++, p -= d) {
+            setCell(fm, mb, p);
+        }
+    }
+}
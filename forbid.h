@@ -0,0 +1,41 @@
+// 금수(렌주 규칙) 위치 맵 헤더
+//
+// 한 색(보통 흑)에 대해 쌍삼/쌍사/장목 자리를 칸당 1비트(15x15는 225비트) 비트셋으로 유지한다.
+// 돌 하나가 바뀌면 그 돌을 지나는 4개 라인 위 ±5칸만 다시 판정한다
+// (6칸 이상 떨어진 칸은 사이가 모두 같은 색이어도 장목 여부가 바뀌지 않음).
+// 4는 한 수 더 두면 정확히 5목이 되는 모양(띈 4 X.XXX, XX.XX 포함, 한 라인에 둘일 수 있음),
+// 열린 3은 한 수 더 두면 열린 4(.XXXX.)가 되는 모양(띈 3 .X.XX. 포함)이다.
+// 열린 3을 만드는 자리가 다시 금수인지는 따지지 않는다(한 단계 판정).
+// 정확히 5목이 되는 자리는 금수가 아니다.
+
+#ifndef FORBID_H
+#define FORBID_H
+
+#include "mailbox.h"
+
+#define FORBID_33 1             // 열린3 두 개 이상
+#define FORBID_44 2             // 4 두 개 이상
+#define FORBID_OVERLINE 4       // 6목 이상
+#define FORBID_RENJU (FORBID_33 | FORBID_44 | FORBID_OVERLINE)
+
+#define FORBID_WORDS ((MB_BOARD_SIZE * MB_BOARD_SIZE + 31) / 32)
+
+typedef struct {
+    unsigned int bits[FORBID_WORDS];    // 비트 row * MB_BOARD_SIZE + col
+    int color;                          // 금수가 적용되는 색
+    int rules;                          // FORBID_* 조합
+} ForbidMap;
+
+// 빈칸 idx에 color를 두면 위반하는 규칙 (FORBID_* 비트, 없으면 0)
+int forbidCheckCell(const unsigned char *mb, int idx, int color, int rules);
+
+void forbidInit(ForbidMap *fm, int color, int rules);
+void forbidRebuild(ForbidMap *fm, const unsigned char *mb);     // 보드 전체 재계산
+void forbidUpdate(ForbidMap *fm, const unsigned char *mb, int idx);  // idx 칸 변경 후
+
+static inline int forbidTest(const ForbidMap *fm, int row, int col) {
+    int bit = row * MB_BOARD_SIZE + col;
+    return (fm->bits[bit >> 5] >> (bit & 31)) & 1;
+}
+
+#endif
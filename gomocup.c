@@ -0,0 +1,237 @@
+// 오목 엔진: Gomocup / piskvork 프로토콜 (UI 없음)
+// 엔진 관리 프로그램과 표준 입출력의 한 줄 명령으로 통신한다.
+//
+// 지원 명령: START, RESTART, BEGIN, TURN, BOARD, INFO, TAKEBACK, ABOUT, END
+// 좌표는 프로토콜대로 "x,y" = (열, 행), 0부터 시작.
+//
+// 사용법: ./omok_engine [--mcts]  (19x19는 같은 소스로 빌드한 ./omok_engine19, START 19)
+// (--mcts: 어려움 모드를 MCTS로 탐색, max_memory가 노드 풀보다 작으면 Alpha-Beta)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include "minimax.h"
+#include "mcts.h"
+#include "forbid.h"
+
+#define LINE_MAX_LEN 256
+#define OWN 1                       // BOARD 명령의 필드 값
+#define OPP 2
+
+#define DEFAULT_TURN_MS 5000        // INFO timeout_turn이 오기 전 기본값
+#define FAST_TURN_MS 100            // timeout_turn 0 = 가능한 빨리
+#define MIN_TURN_MS 50
+#define MATCH_MOVES_AHEAD 25        // 남은 대국 시간을 이 수만큼 나눠 씀
+
+#define RULE_EXACT_FIVE 1           // INFO rule 비트
+#define RULE_RENJU 4
+
+// 엔진 입장 보드 (OWN / OPP / EMPTY)
+static int cells[BOARD_SIZE][BOARD_SIZE];
+static int gameStarted = 0;
+
+// INFO로 받는 제한 (ms, 바이트, 0 = 제한 없음)
+static int timeoutTurn = DEFAULT_TURN_MS;
+static int timeoutMatch = 0;
+static int timeLeft = 0;
+static long maxMemory = 0;
+static int wantMcts = 0;
+
+// 응답 한 줄 (관리 프로그램이 바로 읽도록 매번 flush)
+static void reply(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    putchar('\n');
+    fflush(stdout);
+}
+
+static void resetGame(void) {
+    memset(cells, 0, sizeof(cells));
+    mctsReset();
+    gameStarted = 1;
+}
+
+// 이번 수에 쓸 시계: 턴 제한과 (대국 제한이 있으면) 남은 시간의 몫 중 작은 값
+static int moveBudget(void) {
+    int budget = (timeoutTurn > 0) ? timeoutTurn : FAST_TURN_MS;
+
+    if (timeoutMatch > 0 && timeLeft > 0) {
+        int share = timeLeft / MATCH_MOVES_AHEAD;
+        if (share < budget) budget = share;
+    }
+    return (budget < MIN_TURN_MS) ? MIN_TURN_MS : budget;
+}
+
+// 메모리 제한 안에서 가능한 탐색 엔진 선택
+static void applyEngine(void) {
+    int useMcts = wantMcts && (maxMemory == 0 || mctsMemoryBytes() <= maxMemory);
+    setSearchEngine(useMcts ? ENGINE_MCTS : ENGINE_ALPHABETA);
+}
+
+// "x,y" 파싱 (범위 밖이면 0)
+static int parseXY(const char *text, int *x, int *y) {
+    if (sscanf(text, "%d,%d", x, y) != 2) return 0;
+    return *x >= 0 && *x < BOARD_SIZE && *y >= 0 && *y < BOARD_SIZE;
+}
+
+// 엔진 차례: 돌 수로 색을 정하고 (같으면 흑) 탐색 후 착수 출력
+static void think(void) {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int own = 0, opp = 0;
+
+    for (int y = 0; y < BOARD_SIZE; y++) {
+        for (int x = 0; x < BOARD_SIZE; x++) {
+            if (cells[y][x] == OWN) own++;
+            else if (cells[y][x] == OPP) opp++;
+        }
+    }
+    int myColor = (own == opp) ? BLACK : WHITE;
+    int oppColor = (myColor == BLACK) ? WHITE : BLACK;
+
+    for (int y = 0; y < BOARD_SIZE; y++) {
+        for (int x = 0; x < BOARD_SIZE; x++) {
+            board[y][x] = (cells[y][x] == OWN) ? myColor : (cells[y][x] == OPP) ? oppColor : EMPTY;
+        }
+    }
+
+    int budget = moveBudget();
+    setTurnTime(budget);
+    setSearchTimeBudget(budget / 3);
+    applyEngine();
+
+    Move move = findBestMove(board, myColor, HARD);
+
+    // 예외: 엔진이 빈칸을 못 고르면 첫 빈칸
+    if (move.row < 0 || move.col < 0 || cells[move.row][move.col] != EMPTY) {
+        move.row = -1;
+        for (int y = 0; y < BOARD_SIZE && move.row < 0; y++) {
+            for (int x = 0; x < BOARD_SIZE; x++) {
+                if (cells[y][x] == EMPTY) {
+                    move.row = y;
+                    move.col = x;
+                    break;
+                }
+            }
+        }
+        if (move.row < 0) {
+            reply("ERROR board is full");
+            return;
+        }
+    }
+
+    cells[move.row][move.col] = OWN;
+    reply("%d,%d", move.col, move.row);
+}
+
+static void handleInfo(char *args) {
+    char key[64];
+    char value[LINE_MAX_LEN];
+
+    value[0] = '\0';
+    if (sscanf(args, "%63s %255[^\n]", key, value) < 1) return;
+
+    if (strcmp(key, "timeout_turn") == 0) {
+        timeoutTurn = atoi(value);
+    } else if (strcmp(key, "timeout_match") == 0) {
+        timeoutMatch = atoi(value);
+    } else if (strcmp(key, "time_left") == 0) {
+        timeLeft = atoi(value);
+    } else if (strcmp(key, "max_memory") == 0) {
+        maxMemory = atol(value);
+    } else if (strcmp(key, "rule") == 0) {
+        int rule = atoi(value);
+        setForbiddenRules((rule & RULE_RENJU) ? FORBID_RENJU : 0);
+        if (rule & RULE_EXACT_FIVE) {
+            reply("MESSAGE exact-five rule is not supported, overlines count as wins");
+        }
+    }
+    // game_type, evaluate, folder 등은 무시
+}
+
+// BOARD 명령: DONE까지 "x,y,field" 줄을 받은 뒤 엔진 차례
+static void handleBoard(void) {
+    char line[LINE_MAX_LEN];
+
+    resetGame();
+    while (fgets(line, sizeof(line), stdin)) {
+        int x, y, field;
+        if (strncmp(line, "DONE", 4) == 0) break;
+        if (sscanf(line, "%d,%d,%d", &x, &y, &field) == 3 &&
+            x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE) {
+            cells[y][x] = (field == OWN) ? OWN : (field == OPP) ? OPP : EMPTY;
+        }
+    }
+    think();
+}
+
+int main(int argc, char *argv[]) {
+    char line[LINE_MAX_LEN];
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mcts") == 0) wantMcts = 1;
+    }
+
+    initAI();
+
+    while (fgets(line, sizeof(line), stdin)) {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // 명령어는 대소문자 구분 없이
+        char *args = line;
+        while (*args && !isspace((unsigned char)*args)) {
+            *args = (char)toupper((unsigned char)*args);
+            args++;
+        }
+        if (*args) *args++ = '\0';
+        while (isspace((unsigned char)*args)) args++;
+
+        if (strcmp(line, "START") == 0) {
+            if (atoi(args) != BOARD_SIZE) {
+                reply("ERROR unsupported size, only %d is supported", BOARD_SIZE);
+            } else {
+                resetGame();
+                reply("OK");
+            }
+        } else if (strcmp(line, "RESTART") == 0) {
+            resetGame();
+            reply("OK");
+        } else if (strcmp(line, "BEGIN") == 0) {
+            if (!gameStarted) resetGame();
+            think();
+        } else if (strcmp(line, "TURN") == 0) {
+            int x, y;
+            if (!parseXY(args, &x, &y) || cells[y][x] != EMPTY) {
+                reply("ERROR invalid move");
+                continue;
+            }
+            cells[y][x] = OPP;
+            think();
+        } else if (strcmp(line, "BOARD") == 0) {
+            handleBoard();
+        } else if (strcmp(line, "INFO") == 0) {
+            handleInfo(args);
+        } else if (strcmp(line, "TAKEBACK") == 0) {
+            int x, y;
+            if (!parseXY(args, &x, &y)) {
+                reply("ERROR invalid coordinates");
+                continue;
+            }
+            cells[y][x] = EMPTY;
+            mctsReset();
+            reply("OK");
+        } else if (strcmp(line, "ABOUT") == 0) {
+            reply("name=\"omok\", version=\"1.0\", author=\"omok team 10\", country=\"KR\"");
+        } else if (strcmp(line, "END") == 0) {
+            break;
+        } else if (line[0] != '\0') {
+            reply("UNKNOWN command %s", line);
+        }
+    }
+
+    cleanupAI();
+    return 0;
+}
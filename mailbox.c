@@ -0,0 +1,23 @@
+// 메일박스 보드 공용 커널 (엔진, 서버, 클라이언트 공용)
+
+#include <string.h>
+#include "mailbox.h"
+
+const int MB_DIR[4] = {MB_DIR_H, MB_DIR_V, MB_DIR_D, MB_DIR_A};
+
+void mbInit(unsigned char *mb) {
+    memset(mb, MB_WALL, MB_CELLS);
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        memset(&mb[MB_INDEX(row, 0)], MB_EMPTY, MB_BOARD_SIZE);
+    }
+}
+
+void mbFromBoard(unsigned char *mb, int board[MB_BOARD_SIZE][MB_BOARD_SIZE]) {
+    memset(mb, MB_WALL, MB_CELLS);
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        unsigned char *line = &mb[MB_INDEX(row, 0)];
+        for (int col = 0; col < MB_BOARD_SIZE; col++) {
+            line[col] = (unsigned char)board[row][col];
+        }
+    }
+}
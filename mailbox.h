@@ -0,0 +1,121 @@
+// 테두리(sentinel) 칸을 둔 1차원 메일박스 보드
+//
+// 15x15 보드를 사방 3칸 벽(MB_WALL)으로 둘러싼 21x21 바이트 배열로 표현한다.
+// 벽은 흑/백/빈칸 어느 것과도 같지 않으므로 라인 탐색이 경계에서 저절로 멈추고,
+// 좌표 범위 검사가 필요 없다. 보드 전체가 441바이트(캐시 라인 7개)에 들어간다.
+//
+// 보드 크기는 컴파일 시 고정한다 (기본 15, -DOMOK_BOARD_SIZE=19로 19x19 엔진 빌드).
+// 엔진 핫패스의 루프 한계와 표 크기는 모두 이 상수에서 나온다. 여러 크기를 한
+// 프로세스에서 다루는 서버는 크기별로 찍어 낸 커널(mbInit15/mbInit19 등)을 고른다.
+
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <string.h>
+#include "profile.h"
+
+#ifndef OMOK_BOARD_SIZE
+#define OMOK_BOARD_SIZE 15
+#endif
+#if OMOK_BOARD_SIZE != 15 && OMOK_BOARD_SIZE != 19
+#error "OMOK_BOARD_SIZE는 15 또는 19만 지원합니다"
+#endif
+
+#define MB_MAX_BOARD_SIZE 19
+#define MB_PAD 3
+#define MB_EMPTY 0
+#define MB_WALL 3
+
+// 크기 n 보드의 메일박스 모양 (상수 n이면 모두 컴파일 시 상수)
+#define MB_STRIDE_N(n) ((n) + 2 * MB_PAD)
+#define MB_CELLS_N(n) (MB_STRIDE_N(n) * MB_STRIDE_N(n))
+#define MB_INDEX_N(n, row, col) (((row) + MB_PAD) * MB_STRIDE_N(n) + (col) + MB_PAD)
+
+#define MB_BOARD_SIZE OMOK_BOARD_SIZE
+#define MB_STRIDE MB_STRIDE_N(MB_BOARD_SIZE)        // 15: 21, 19: 25
+#define MB_CELLS MB_CELLS_N(MB_BOARD_SIZE)          // 15: 441, 19: 625
+
+// (row, col) <-> 1차원 인덱스
+#define MB_INDEX(row, col) MB_INDEX_N(MB_BOARD_SIZE, row, col)
+#define MB_ROW(idx) ((idx) / MB_STRIDE - MB_PAD)
+#define MB_COL(idx) ((idx) % MB_STRIDE - MB_PAD)
+
+// 방향별 인덱스 오프셋 (가로, 세로, 대각선, 역대각선): +1, +21, +22, -20
+#define MB_DIR_H 1
+#define MB_DIR_V MB_STRIDE
+#define MB_DIR_D (MB_STRIDE + 1)
+#define MB_DIR_A (-(MB_STRIDE - 1))
+extern const int MB_DIR[4];
+
+void mbInit(unsigned char *mb);     // 모든 칸 빈칸 + 테두리 벽
+void mbFromBoard(unsigned char *mb, int board[MB_BOARD_SIZE][MB_BOARD_SIZE]);
+
+// 탐색 핫패스 커널은 인라인 (벽에서 자동으로 멈추므로 범위 검사 없음)
+
+// idx에 놓인 color 돌이 5목 이상인지 (dirs: 보드 보폭에 맞는 4방향 오프셋)
+static inline int mbCheckWinDirs(const unsigned char *mb, int idx, int color, const int dirs[4]) {
+    for (int dir = 0; dir < 4; dir++) {
+        int d = dirs[dir];
+        int count = 1;
+        int p = idx + d;
+        while (mb[p] == color) {
+            count++;
+            p += d;
+        }
+        p = idx - d;
+        while (mb[p] == color) {
+            count++;
+            p -= d;
+        }
+        if (count >= 5) return 1;
+    }
+    return 0;
+}
+
+static inline int mbCheckWin(const unsigned char *mb, int idx, int color) {
+    return mbCheckWinDirs(mb, idx, color, MB_DIR);
+}
+
+// 크기별 커널 찍어 내기: mbInit##n, mbCheckWin##n (보폭과 루프 한계가 상수인 사본)
+#define MB_SIZED_KERNELS(n) \
+    static inline void mbInit##n(unsigned char *mb) { \
+        memset(mb, MB_WALL, MB_CELLS_N(n)); \
+        for (int row = 0; row < (n); row++) { \
+            memset(&mb[MB_INDEX_N(n, row, 0)], MB_EMPTY, (n)); \
+        } \
+    } \
+    static inline int mbCheckWin##n(const unsigned char *mb, int idx, int color) { \
+        static const int dirs[4] = {1, MB_STRIDE_N(n), MB_STRIDE_N(n) + 1, -(MB_STRIDE_N(n) - 1)}; \
+        return mbCheckWinDirs(mb, idx, color, dirs); \
+    }
+
+MB_SIZED_KERNELS(15)
+MB_SIZED_KERNELS(19)
+
+// idx를 지나는 dir 방향 연속 돌 수와 열린 끝 수 (idx 칸은 color로 간주)
+static inline void mbAnalyzeLine(const unsigned char *mb, int idx, int dir, int color,
+                                 int *count, int *openEnds) {
+    PROF_BEGIN(PROF_ANALYZE_LINE);
+    int c = 1;
+    int open = 0;
+
+    int p = idx + dir;
+    while (mb[p] == color) {
+        c++;
+        p += dir;
+    }
+    if (mb[p] == MB_EMPTY) open++;
+
+    p = idx - dir;
+    while (mb[p] == color) {
+        c++;
+        p -= dir;
+    }
+    if (mb[p] == MB_EMPTY) open++;
+
+    *count = c;
+    *openEnds = open;
+    PROF_END(PROF_ANALYZE_LINE);
+}
+
+#endif
@@ -0,0 +1,446 @@
+// 오목 AI - 멀티스레드 Monte Carlo Tree Search (어려움 모드 대체 백엔드)
+// 핵심: 트리 병렬화 + 가상 손실, 노드 풀 할당, 수 사이 트리 재사용
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "minimax.h"
+#include "ai_internal.h"
+#include "mcts.h"
+#include "timeman.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#define MCTS_POOL_SIZE (1 << 19)   // 풀 하나당 노드 수 (풀 2개를 번갈아 사용)
+#define MCTS_MAX_CHILDREN 20       // 노드당 최대 자식 수 (평가 점수 상위)
+#define MCTS_MAX_THREADS 64
+#define MCTS_MAX_PATH (BOARD_SIZE * BOARD_SIZE + 1)
+#define MCTS_VALUE_SCALE 1024      // 가치 누적용 고정소수점 배율
+#define MCTS_EVAL_SCALE 3000.0     // evaluateBoard 점수 → 승률 변환 폭
+#define MCTS_PUCT 1.5              // 탐험 상수
+#define MCTS_FPU 0.4               // 미방문 자식의 기본 가치
+
+// 노드 전개 상태
+enum { NODE_LEAF = 0, NODE_EXPANDING = 1, NODE_EXPANDED = 2 };
+
+// 트리 노드 (풀 인덱스로 연결, 자식은 연속 블록)
+typedef struct {
+    atomic_int visits;
+    atomic_int virtualLoss;     // 탐색 중인 스레드 수 (패배로 간주)
+    atomic_llong valueSum;      // color 입장 가치 합 (x MCTS_VALUE_SCALE)
+    atomic_int state;
+    int firstChild;             // state == NODE_EXPANDED 일 때 유효
+    int childCount;
+    float prior;                // 수 순서 기반 사전 확률
+    short move;                 // 이 노드로 오는 수 (row * BOARD_SIZE + col)
+    unsigned char color;        // move를 둔 색
+    unsigned char terminal;     // move로 5목 완성
+} MctsNode;
+
+// 후보 수 (전개 시 정렬용)
+typedef struct {
+    int move;
+    int score;
+} MctsCandidate;
+
+static MctsNode *pools[2] = {NULL, NULL};
+static int activePool = 0;
+static atomic_int poolUsed;
+
+// 현재 트리의 루트 상태
+static int rootIdx = -1;
+static unsigned char rootBoard[MB_CELLS];
+static int rootToMove = BLACK;
+
+static int threadSetting = 0;
+static atomic_int stopFlag;
+static atomic_llong playoutCount;
+static long long searchDeadline = 0;
+static MctsStats lastStats;
+
+static int cpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+static int otherColor(int color) {
+    return (color == BLACK) ? WHITE : BLACK;
+}
+
+// 풀에서 연속된 노드 count개 할당 (실패 시 -1)
+static int allocNodes(int count) {
+    if (atomic_load(&poolUsed) + count > MCTS_POOL_SIZE) return -1;
+    int idx = atomic_fetch_add(&poolUsed, count);
+    if (idx + count > MCTS_POOL_SIZE) return -1;
+    return idx;
+}
+
+static void initNode(MctsNode *node, int move, int color, float prior) {
+    atomic_init(&node->visits, 0);
+    atomic_init(&node->virtualLoss, 0);
+    atomic_init(&node->valueSum, 0);
+    atomic_init(&node->state, NODE_LEAF);
+    node->firstChild = -1;
+    node->childCount = 0;
+    node->prior = prior;
+    node->move = (short)move;
+    node->color = (unsigned char)color;
+    node->terminal = 0;
+}
+
+static int compareCandidates(const void *a, const void *b) {
+    return ((MctsCandidate*)b)->score - ((MctsCandidate*)a)->score;
+}
+
+// 노드 전개: 평가 점수 상위 후보를 자식으로 추가 (즉시 승리/필수 방어는 그 수만)
+static int expandNode(MctsNode *pool, MctsNode *node, unsigned char *board, int toMove) {
+    Move moves[MAX_MOVES_HARD];
+    MctsCandidate candidates[MAX_MOVES_HARD];
+    int moveCount = getPossibleMovesHard(board, moves, MAX_MOVES_HARD);
+    int opponent = otherColor(toMove);
+    int count = 0;
+    int winMove = -1;
+    int blockCount = 0;
+
+    for (int i = 0; i < moveCount; i++) {
+        int attack = evaluatePosition(board, MB_INDEX(moves[i].row, moves[i].col), toMove);
+        int defense = evaluatePosition(board, MB_INDEX(moves[i].row, moves[i].col), opponent);
+        int move = moves[i].row * BOARD_SIZE + moves[i].col;
+
+        if (attack >= SCORE_FIVE) {
+            winMove = move;
+            break;
+        }
+        if (defense >= SCORE_FIVE) {
+            // 상대 5목 자리는 앞쪽에 모아둠
+            candidates[count] = candidates[blockCount];
+            candidates[blockCount].move = move;
+            candidates[blockCount].score = defense;
+            blockCount++;
+            count++;
+            continue;
+        }
+        candidates[count].move = move;
+        candidates[count].score = attack + defense * 9 / 10;
+        count++;
+    }
+
+    if (winMove >= 0) {
+        candidates[0].move = winMove;
+        count = 1;
+    } else if (blockCount > 0) {
+        count = blockCount;
+    } else {
+        qsort(candidates, count, sizeof(MctsCandidate), compareCandidates);
+        if (count > MCTS_MAX_CHILDREN) count = MCTS_MAX_CHILDREN;
+    }
+
+    int first = (count > 0) ? allocNodes(count) : 0;
+    if (first < 0) return 0;
+
+    // 순위 기반 사전 확률 (1/(i+1) 정규화)
+    double total = 0.0;
+    for (int i = 0; i < count; i++) total += 1.0 / (i + 1);
+
+    for (int i = 0; i < count; i++) {
+        MctsNode *child = &pool[first + i];
+        initNode(child, candidates[i].move, toMove, (float)((1.0 / (i + 1)) / total));
+        child->terminal = (winMove >= 0);
+    }
+
+    node->firstChild = first;
+    node->childCount = count;
+    return 1;
+}
+
+// PUCT 선택 (가상 손실은 방문 + 패배로 계산)
+static int selectChild(MctsNode *pool, MctsNode *node) {
+    int parentVisits = atomic_load(&node->visits) + atomic_load(&node->virtualLoss);
+    double sqrtParent = sqrt((double)parentVisits + 1.0);
+    int best = 0;
+    double bestScore = -1e18;
+
+    for (int i = 0; i < node->childCount; i++) {
+        MctsNode *child = &pool[node->firstChild + i];
+        int n = atomic_load(&child->visits) + atomic_load(&child->virtualLoss);
+        double q = (n == 0) ? MCTS_FPU
+                            : (double)atomic_load(&child->valueSum) / MCTS_VALUE_SCALE / n;
+        double u = MCTS_PUCT * child->prior * sqrtParent / (1.0 + n);
+
+        if (q + u > bestScore) {
+            bestScore = q + u;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// 리프 가치: 정적 평가를 color 입장 승률로 변환
+static double leafValue(const unsigned char *board, int color) {
+    double score = (double)evaluateBoardMb(board, color);
+    return 1.0 / (1.0 + exp(-score / MCTS_EVAL_SCALE));
+}
+
+// 플레이아웃 1회: 선택 → 전개 → 평가 → 역전파
+static void playout(MctsNode *pool, unsigned char *board) {
+    int path[MCTS_MAX_PATH];
+    int pathLen = 0;
+    int idx = rootIdx;
+    int toMove = rootToMove;
+    double value;   // path 마지막 노드의 color 입장 가치
+
+    memcpy(board, rootBoard, sizeof(rootBoard));
+
+    for (;;) {
+        MctsNode *node = &pool[idx];
+        atomic_fetch_add(&node->virtualLoss, 1);
+        path[pathLen++] = idx;
+
+        if (node->terminal) {
+            value = 1.0;
+            break;
+        }
+
+        int state = atomic_load_explicit(&node->state, memory_order_acquire);
+        if (state != NODE_EXPANDED) {
+            int expected = NODE_LEAF;
+            if (state == NODE_LEAF &&
+                atomic_compare_exchange_strong(&node->state, &expected, NODE_EXPANDING)) {
+                int ok = expandNode(pool, node, board, toMove);
+                atomic_store_explicit(&node->state, ok ? NODE_EXPANDED : NODE_LEAF,
+                                      memory_order_release);
+            }
+            value = leafValue(board, node->color);
+            break;
+        }
+
+        // 둘 곳이 없으면 무승부
+        if (node->childCount == 0 || pathLen >= MCTS_MAX_PATH) {
+            value = 0.5;
+            break;
+        }
+
+        idx = node->firstChild + selectChild(pool, node);
+        MctsNode *child = &pool[idx];
+        board[MB_INDEX(child->move / BOARD_SIZE, child->move % BOARD_SIZE)] = (unsigned char)child->color;
+        toMove = otherColor(toMove);
+    }
+
+    // 역전파: 한 단계 올라갈 때마다 관점 반전
+    for (int i = pathLen - 1; i >= 0; i--) {
+        MctsNode *node = &pool[path[i]];
+        atomic_fetch_add(&node->valueSum, (long long)(value * MCTS_VALUE_SCALE));
+        atomic_fetch_add(&node->visits, 1);
+        atomic_fetch_sub(&node->virtualLoss, 1);
+        value = 1.0 - value;
+    }
+}
+
+static void *mctsWorker(void *arg) {
+    MctsNode *pool = (MctsNode*)arg;
+    unsigned char board[MB_CELLS];
+    long long local = 0;
+
+    while (!atomic_load(&stopFlag)) {
+        playout(pool, board);
+        local++;
+        if ((local & 15) == 0 && tmNowMs() >= searchDeadline) {
+            atomic_store(&stopFlag, 1);
+        }
+    }
+
+    atomic_fetch_add(&playoutCount, local);
+    return NULL;
+}
+
+// 전개된 노드에서 move/color 자식 찾기
+static int findChild(MctsNode *pool, int idx, int move, int color) {
+    MctsNode *node = &pool[idx];
+    if (atomic_load(&node->state) != NODE_EXPANDED) return -1;
+    for (int i = 0; i < node->childCount; i++) {
+        MctsNode *child = &pool[node->firstChild + i];
+        if (child->move == move && child->color == color) return node->firstChild + i;
+    }
+    return -1;
+}
+
+// 이전 루트에서 실제로 둔 수(최대 2개)를 따라 내려가 재사용할 노드 찾기
+static int findReusableRoot(const unsigned char *board, int aiColor) {
+    int added[2];
+    int addedCount = 0;
+
+    if (rootIdx < 0) return -1;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int cell = MB_INDEX(row, col);
+            if (rootBoard[cell] == board[cell]) continue;
+            // 돌이 사라졌거나 3수 이상 진행됐으면 다른 국면
+            if (rootBoard[cell] != EMPTY || addedCount >= 2) return -1;
+            added[addedCount++] = row * BOARD_SIZE + col;
+        }
+    }
+
+    MctsNode *pool = pools[activePool];
+    int idx = rootIdx;
+    int toMove = rootToMove;
+    int used[2] = {0, 0};
+
+    for (int step = 0; step < addedCount; step++) {
+        int move = -1;
+        for (int i = 0; i < addedCount; i++) {
+            if (!used[i] && board[MB_INDEX(added[i] / BOARD_SIZE, added[i] % BOARD_SIZE)] == toMove) {
+                used[i] = 1;
+                move = added[i];
+                break;
+            }
+        }
+        if (move < 0) return -1;
+        idx = findChild(pool, idx, move, toMove);
+        if (idx < 0) return -1;
+        toMove = otherColor(toMove);
+    }
+
+    return (toMove == aiColor) ? idx : -1;
+}
+
+// 재사용할 서브트리를 다른 풀로 BFS 복사 (자식 블록 연속성 유지)
+static int compactTree(int oldRoot) {
+    MctsNode *src = pools[activePool];
+    MctsNode *dst = pools[1 - activePool];
+    int used = 1;
+
+    memcpy(&dst[0], &src[oldRoot], sizeof(MctsNode));
+
+    for (int scan = 0; scan < used; scan++) {
+        MctsNode *node = &dst[scan];
+        if (atomic_load(&node->state) != NODE_EXPANDED) {
+            atomic_store(&node->state, NODE_LEAF);
+            continue;
+        }
+        memcpy(&dst[used], &src[node->firstChild], sizeof(MctsNode) * node->childCount);
+        node->firstChild = used;
+        used += node->childCount;
+    }
+
+    activePool = 1 - activePool;
+    atomic_store(&poolUsed, used);
+    rootIdx = 0;
+    return used;
+}
+
+// MCTS 탐색
+Move mctsSearch(const unsigned char *board, int aiColor, int timeMs) {
+    Move best = {-1, -1};
+    long long start = tmNowMs();
+
+    if (pools[0] == NULL) {
+        pools[0] = (MctsNode*)malloc(sizeof(MctsNode) * MCTS_POOL_SIZE);
+        pools[1] = (MctsNode*)malloc(sizeof(MctsNode) * MCTS_POOL_SIZE);
+        if (pools[0] == NULL || pools[1] == NULL) {
+            mctsCleanup();
+            return best;
+        }
+        rootIdx = -1;
+    }
+
+    // 트리 재사용 또는 새 트리
+    int reuse = findReusableRoot(board, aiColor);
+    if (reuse >= 0) {
+        lastStats.reusedNodes = compactTree(reuse);
+    } else {
+        lastStats.reusedNodes = 0;
+        atomic_store(&poolUsed, 0);
+        rootIdx = allocNodes(1);
+        initNode(&pools[activePool][rootIdx], -1, otherColor(aiColor), 1.0f);
+    }
+    memcpy(rootBoard, board, sizeof(rootBoard));
+    rootToMove = aiColor;
+
+    MctsNode *pool = pools[activePool];
+    int threads = (threadSetting > 0) ? threadSetting : cpuCount();
+    if (threads > MCTS_MAX_THREADS) threads = MCTS_MAX_THREADS;
+
+    atomic_store(&stopFlag, 0);
+    atomic_store(&playoutCount, 0);
+    searchDeadline = start + timeMs;
+
+    // 루트를 먼저 전개: 둘 수 있는 수가 하나뿐이면 탐색 생략
+    unsigned char scratch[MB_CELLS];
+    playout(pool, scratch);
+    atomic_fetch_add(&playoutCount, 1);
+
+    MctsNode *root = &pool[rootIdx];
+    int runningThreads = 1;
+    if (atomic_load(&root->state) == NODE_EXPANDED && root->childCount > 1) {
+        pthread_t workers[MCTS_MAX_THREADS];
+        int started = 0;
+        for (int i = 1; i < threads; i++) {
+            if (pthread_create(&workers[started], NULL, mctsWorker, pool) == 0) started++;
+        }
+        mctsWorker(pool);
+        for (int i = 0; i < started; i++) {
+            pthread_join(workers[i], NULL);
+        }
+        runningThreads += started;
+    }
+
+    // 방문 수가 가장 많은 자식 선택
+    if (atomic_load(&root->state) == NODE_EXPANDED) {
+        int bestVisits = -1;
+        for (int i = 0; i < root->childCount; i++) {
+            MctsNode *child = &pool[root->firstChild + i];
+            int visits = atomic_load(&child->visits);
+            if (visits > bestVisits) {
+                bestVisits = visits;
+                best.row = child->move / BOARD_SIZE;
+                best.col = child->move % BOARD_SIZE;
+            }
+        }
+    }
+
+    lastStats.playouts = atomic_load(&playoutCount);
+    lastStats.nodes = atomic_load(&poolUsed);
+    if (lastStats.nodes > MCTS_POOL_SIZE) lastStats.nodes = MCTS_POOL_SIZE;
+    lastStats.threads = runningThreads;
+    lastStats.elapsedMs = (int)(tmNowMs() - start);
+
+    return best;
+}
+
+void mctsGetStats(MctsStats *stats) {
+    *stats = lastStats;
+}
+
+void mctsSetThreads(int threads) {
+    threadSetting = (threads > 0) ? threads : 0;
+}
+
+void mctsReset(void) {
+    rootIdx = -1;
+}
+
+void mctsCleanup(void) {
+    free(pools[0]);
+    free(pools[1]);
+    pools[0] = NULL;
+    pools[1] = NULL;
+    rootIdx = -1;
+}
+
+long mctsMemoryBytes(void) {
+    return (long)(sizeof(MctsNode) * MCTS_POOL_SIZE * 2);
+}
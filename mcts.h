@@ -0,0 +1,27 @@
+// Monte Carlo Tree Search 헤더 파일 (어려움 모드 대체 백엔드)
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "minimax.h"
+#include "mailbox.h"
+
+// 마지막 탐색 통계
+typedef struct {
+    long long playouts;     // 완료된 플레이아웃 수
+    int nodes;              // 사용 중인 트리 노드 수
+    int reusedNodes;        // 이전 수에서 재사용한 노드 수
+    int threads;            // 탐색 스레드 수
+    int elapsedMs;          // 실제 소요 시간
+} MctsStats;
+
+// timeMs 동안 UCT 탐색 후 방문 수가 가장 많은 수 반환 (board는 메일박스)
+Move mctsSearch(const unsigned char *board, int aiColor, int timeMs);
+
+void mctsGetStats(MctsStats *stats);
+void mctsSetThreads(int threads);   // 0 = CPU 코어 수
+void mctsReset(void);               // 재사용 트리 폐기 (새 게임 시작 시)
+void mctsCleanup(void);             // 노드 풀 해제
+long mctsMemoryBytes(void);         // 노드 풀 전체 크기 (메모리 제한 판단용)
+
+#endif
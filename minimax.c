@@ -6,32 +6,137 @@
 #include <string.h>
 #include <limits.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "minimax.h"
+#include "ai_internal.h"
+#include "mcts.h"
+#include "nnue.h"
+#include "anacache.h"
+#include "forbid.h"
+#include "timeman.h"
+#include "pattern.h"
+#include "profile.h"
+#include "trace.h"
+#include "vcf.h"
+#include "bitboard.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
 
 #define MAX_MOVES 60
-#define MAX_MOVES_HARD 100  // 어려움 모드: 더 많은 후보 고려
-#define INFINITY_SCORE 10000000
-
-// 방향 벡터 (가로, 세로, 대각선 2개)
-static const int DX[] = {1, 0, 1, 1};
-static const int DY[] = {0, 1, 1, -1};
-
-// 패턴 점수
-typedef enum {
-    SCORE_FIVE      = 1000000,   // 5목 (즉시 승리)
-    SCORE_OPEN_FOUR = 100000,    // 열린 4 (막을 수 없음)
-    SCORE_FOUR      = 15000,     // 닫힌 4 (한쪽 막힘)
-    SCORE_OPEN_THREE= 5000,      // 열린 3
-    SCORE_THREE     = 800,       // 닫힌 3
-    SCORE_OPEN_TWO  = 300,       // 열린 2
-    SCORE_TWO       = 50,        // 닫힌 2
-    SCORE_ONE       = 10         // 1개
-} PatternScore;
-
-// 위치 가중치 (중앙 우선)
-static int positionWeight[BOARD_SIZE][BOARD_SIZE];
+
+// 설정과 initAI가 채우는 테이블은 프로세스 공용, 탐색 중 상태(_Thread_local)는 스레드별.
+// initAI 뒤에는 여러 스레드가 각자 findBestMove/findBestMoves를 동시에 부를 수 있다
+// (MCTS 백엔드와 분석 캐시 기록은 제외)
+
+// 위치 가중치 (중앙 우선, 메일박스 인덱스 기준)
+static int positionWeight[MB_CELLS];
 static int initialized = 0;
 
+// 탐색 설정 (어려움 모드 백엔드, MCTS 시간 예산)
+static int searchEngine = ENGINE_ALPHABETA;
+static int searchTimeBudgetMs = 3000;
+
+// 마지막 탐색의 노드 수 (처리량 비교용)
+static _Thread_local long long searchNodes = 0;
+
+// 신경망 평가 (가중치 파일이 있을 때만 사용, 탐색 중에만 누산기 유효)
+static int neuralEvalEnabled = 1;
+static _Thread_local int nnueActive = 0;
+static _Thread_local NnueAccumulator searchAcc;
+
+// 흑 금수 규칙 (0이면 끔, 켜면 탐색 중 착수/무르기마다 금수 맵 증분 갱신)
+static int forbidRules = 0;
+static _Thread_local ForbidMap searchForbid;
+
+// 패턴 보드 (탐색 중인 메일박스와 함께 갱신, 그 보드에 대한 evaluatePosition이 사용)
+static _Thread_local PatternBoard searchPatterns;
+static _Thread_local const unsigned char *patternMb = NULL;
+
+// 패턴 코드별 라인 점수 (PAT_CODE 순서)
+static const int patternScore[PAT_CODES] = {
+    0, 0, 0,                                // 0개
+    0, SCORE_ONE, SCORE_ONE * 2,            // 1개: 막힘, 한쪽, 양쪽
+    0, SCORE_TWO, SCORE_OPEN_TWO,           // 2개
+    0, SCORE_THREE, SCORE_OPEN_THREE,       // 3개
+    0, SCORE_FOUR, SCORE_OPEN_FOUR,         // 4개
+    SCORE_FIVE                              // 5개 이상
+};
+
+// 턴 시계 (0이면 난이도별 시간 상한만, 켜면 반복 심화 시간 관리 + 하드 데드라인)
+static int turnTimeMs = 0;
+static _Thread_local int clockActive = 0;
+static _Thread_local int searchAborted = 0;
+static _Thread_local TimeManager searchClock;
+
+// 포트폴리오 탐색: 어려움 모드 Alpha-Beta 동안 다른 스레드가 양쪽 VCF(vcf.h)를 증명
+// 내 승리를 먼저 증명하면 본 탐색을 끊고 그 수를 두고, 상대 승리를 증명하면 그 수순의
+// 칸들을 루트 후보 정렬 앞으로 올린다. 본 탐색이 먼저 끝나면 증명 스레드를 멈춤
+#define PORTFOLIO_MAX_FOURS 20
+#define PORTFOLIO_NODE_CAP 2000000
+
+typedef struct {
+    unsigned char mb[MB_CELLS];     // 증명 스레드 전용 보드 사본
+    int aiColor;
+    int rules;
+    atomic_int stop;                // 본 탐색이 끝남
+    atomic_int ownWin;              // 1이면 winMove가 증명된 승리 수
+    atomic_int opponentWin;         // 1이면 refute[]가 채워짐
+    Move winMove;
+    unsigned char refute[MB_CELLS]; // 상대 VCF 수순의 칸 (막을 후보)
+} Portfolio;
+
+static int portfolioMode = -1;      // 1 켬, 0 끔, -1 코어 2개 이상이면 켬
+static _Thread_local Portfolio *portfolio = NULL;      // 이 스레드의 본 탐색에 붙은 증명 스레드
+
+// 난이도별 한 수 예산 (difficultyBudget, minimax.h)
+static _Thread_local const SearchBudget *searchBudget = &difficultyBudget[MEDIUM];
+static _Thread_local long long nodeLimit = 0;     // 0 = 제한 없음 (다중 PV 분석)
+
+// 치환표 (findBestMoves 동안만 켜서 k번의 루트 탐색이 공유)
+#define TT_BITS 18
+#define TT_SIZE (1 << TT_BITS)
+#define TT_EXACT 0
+#define TT_LOWER 1      // score 이상 (beta 컷)
+#define TT_UPPER 2      // score 이하 (alpha 미달)
+
+typedef struct {
+    unsigned long long key;
+    int score;
+    short move;             // 메일박스 인덱스 (-1 = 없음)
+    signed char depth;
+    unsigned char flag;
+} TTEntry;
+
+static _Thread_local TTEntry *transTable = NULL;
+static _Thread_local int ttActive = 0;
+static unsigned long long zobristKeys[2][MB_CELLS];
+static unsigned long long zobristMax;      // AI 차례일 때 XOR
+static _Thread_local unsigned long long searchHash;     // 탐색 중(beginSearch 뒤) 항상 갱신
+
+// 평가 캐시: 리프 정적 평가 점수만 저장하는 직접 사상 표 (프로세스 공용, 잠금 없음)
+// 항목 하나가 64비트 원자 변수 하나(상위 32비트 = 키 상위 비트, 하위 32비트 = 점수)라
+// 다른 스레드가 쓰는 중에 읽어도 키와 점수가 섞이지 않는다. 2^15 x 8바이트 = 256KB (L2 크기)
+#define EVAL_CACHE_BITS 15
+#define EVAL_CACHE_SIZE (1 << EVAL_CACHE_BITS)
+
+static atomic_ullong evalCache[EVAL_CACHE_SIZE];
+static unsigned long long evalSalt[2][3];           // [신경망 평가][aiColor] 키에 XOR
+static _Thread_local int evalCacheActive = 0;       // beginSearch ~ endSearch (searchHash 유효)
+static _Thread_local long long evalProbes = 0;      // 마지막 탐색의 조회/적중 수
+static _Thread_local long long evalHits = 0;
+
+static unsigned long long nextRandom64(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
 // AI 초기화
 void initAI(void) {
     if (initialized) return;
@@ -43,127 +148,141 @@ void initAI(void) {
     for (int i = 0; i < BOARD_SIZE; i++) {
         for (int j = 0; j < BOARD_SIZE; j++) {
             int dist = abs(i - center) + abs(j - center);
-            positionWeight[i][j] = (BOARD_SIZE - dist);
+            positionWeight[MB_INDEX(i, j)] = (BOARD_SIZE - dist);
+        }
+    }
+
+    // Zobrist 키 (고정 시드: 실행마다 같은 해시)
+    unsigned long long seed = 0x6F6D6F6B5A4F4252ULL;
+    for (int c = 0; c < 2; c++) {
+        for (int i = 0; i < MB_CELLS; i++) {
+            zobristKeys[c][i] = nextRandom64(&seed);
+        }
+    }
+    zobristMax = nextRandom64(&seed);
+    for (int n = 0; n < 2; n++) {
+        for (int c = 0; c < 3; c++) {
+            evalSalt[n][c] = nextRandom64(&seed);
         }
     }
 
+    // 신경망 가중치 (없으면 패턴 평가만 사용)
+    const char *nnuePath = getenv("OMOK_NNUE");
+    nnueLoad(nnuePath ? nnuePath : NNUE_DEFAULT_FILE);
+
+    // 가중치가 바뀌었을 수 있으므로 평가 캐시 비움
+    for (int i = 0; i < EVAL_CACHE_SIZE; i++) {
+        atomic_store_explicit(&evalCache[i], 0, memory_order_relaxed);
+    }
+
+    // 탐색 트레이스 (tracedump로 분석)
+    const char *tracePath = getenv("OMOK_TRACE");
+    if (tracePath != NULL && !traceOpen(tracePath)) {
+        fprintf(stderr, "탐색 트레이스 파일을 열 수 없습니다: %s\n", tracePath);
+    }
+
     initialized = 1;
 }
 
 // AI 정리
 void cleanupAI(void) {
+    mctsCleanup();
+    nnueUnload();
+    cleanupSearchThread();
+    traceClose();
     initialized = 0;
 }
 
-// 승리 체크
-int checkWinBoard(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
-    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) return 0;
-    if (board[row][col] != color) return 0;
+// 이 스레드의 치환표 해제 (findBestMoves를 부른 작업 스레드가 끝나기 전에 호출)
+void cleanupSearchThread(void) {
+    free(transTable);
+    transTable = NULL;
+}
 
-    for (int dir = 0; dir < 4; dir++) {
-        int count = 1;
+// 신경망 평가 사용 여부 (가중치가 로드된 경우에만 적용)
+void setNeuralEval(int enabled) {
+    neuralEvalEnabled = enabled;
+}
 
-        // 정방향
-        int nx = col + DX[dir];
-        int ny = row + DY[dir];
-        while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
-            count++;
-            nx += DX[dir];
-            ny += DY[dir];
-        }
+// 한 수당 시계 (ms, 0 = 난이도별 노드/시간 예산만)
+void setTurnTime(int ms) {
+    turnTimeMs = (ms > 0) ? ms : 0;
+}
 
-        // 역방향
-        nx = col - DX[dir];
-        ny = row - DY[dir];
-        while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
-            count++;
-            nx -= DX[dir];
-            ny -= DY[dir];
-        }
+// 흑 금수 규칙 설정
+void setForbiddenRules(int rules) {
+    forbidRules = rules;
+}
 
-        if (count >= 5) return 1;
-    }
-    return 0;
+// 어려움 모드 탐색 엔진 선택
+void setSearchEngine(int engine) {
+    searchEngine = (engine == ENGINE_MCTS) ? ENGINE_MCTS : ENGINE_ALPHABETA;
 }
 
-// 한 방향 라인 분석 (연속 돌 수, 열린 끝 수)
-static void analyzeLine(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
-                        int dx, int dy, int color, int *count, int *openEnds) {
-    *count = 1;
-    *openEnds = 0;
+// 한 수당 탐색 시간 예산 (ms)
+void setSearchTimeBudget(int ms) {
+    searchTimeBudgetMs = (ms > 0) ? ms : 1;
+}
 
-    // 정방향
-    int nx = col + dx;
-    int ny = row + dy;
-    while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
-        (*count)++;
-        nx += dx;
-        ny += dy;
-    }
-    if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == EMPTY) {
-        (*openEnds)++;
-    }
+long long getLastSearchNodes(void) {
+    return searchNodes;
+}
 
-    // 역방향
-    nx = col - dx;
-    ny = row - dy;
-    while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
-        (*count)++;
-        nx -= dx;
-        ny -= dy;
+// 어려움 모드 VCF 증명 스레드 (1 켬, 0 끔, 그 밖 = 코어 2개 이상이면 자동)
+void setPortfolioSearch(int mode) {
+    portfolioMode = (mode == 0 || mode == 1) ? mode : -1;
+}
+
+void getEvalCacheStats(long long *probes, long long *hits) {
+    *probes = evalProbes;
+    *hits = evalHits;
+}
+
+// 승리 체크
+int checkWinBoard(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
+    unsigned char mb[MB_CELLS];
+
+    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) return 0;
+    if (board[row][col] != color) return 0;
+
+    mbFromBoard(mb, board);
+    return mbCheckWin(mb, MB_INDEX(row, col), color);
+}
+
+// 빈칸 idx에 color를 둘 때의 방향별 패턴 코드
+// 탐색 보드면 패턴 보드에서 바로 읽고, 아니면 라인을 분석해 local에 채움
+static const unsigned char *cellCodes(const unsigned char *mb, int idx, int color,
+                                      unsigned char local[4]) {
+    if (mb == patternMb) {
+        return searchPatterns.code[idx][color - 1];
     }
-    if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == EMPTY) {
-        (*openEnds)++;
+    for (int dir = 0; dir < 4; dir++) {
+        int count, openEnds;
+        mbAnalyzeLine(mb, idx, MB_DIR[dir], color, &count, &openEnds);
+        local[dir] = (unsigned char)PAT_CODE(count, openEnds);
     }
+    return local;
 }
 
 // 특정 위치에 돌을 놓았을 때 점수 계산
-static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color) {
-    if (board[row][col] != EMPTY) return 0;
+int evaluatePosition(unsigned char *mb, int idx, int color) {
+    if (mb[idx] != EMPTY) return 0;
 
+    PROF_BEGIN(PROF_EVAL_POSITION);
     int score = 0;
     int fours = 0;      // 4목 개수
     int openThrees = 0; // 열린 3 개수
 
-    board[row][col] = color;
+    unsigned char local[4];
+    const unsigned char *codes = cellCodes(mb, idx, color, local);
 
     for (int dir = 0; dir < 4; dir++) {
-        int count, openEnds;
-        analyzeLine(board, row, col, DX[dir], DY[dir], color, &count, &openEnds);
-
-        if (count >= 5) {
-            score += SCORE_FIVE;
-        } else if (count == 4) {
-            if (openEnds == 2) {
-                score += SCORE_OPEN_FOUR;  // 열린 4 = 승리 확정
-            } else if (openEnds == 1) {
-                score += SCORE_FOUR;
-                fours++;
-            }
-        } else if (count == 3) {
-            if (openEnds == 2) {
-                score += SCORE_OPEN_THREE;
-                openThrees++;
-            } else if (openEnds == 1) {
-                score += SCORE_THREE;
-            }
-        } else if (count == 2) {
-            if (openEnds == 2) {
-                score += SCORE_OPEN_TWO;
-            } else if (openEnds == 1) {
-                score += SCORE_TWO;
-            }
-        } else if (count == 1) {
-            if (openEnds == 2) {
-                score += SCORE_ONE * 2;
-            } else if (openEnds == 1) {
-                score += SCORE_ONE;
-            }
-        }
+        int code = codes[dir];
+        score += patternScore[code];
+        if (code == PAT_CODE(4, 1)) fours++;
+        else if (code == PAT_CODE(3, 2)) openThrees++;
     }
 
-    board[row][col] = EMPTY;
-
     // 쌍사 (4목 2개 이상) = 승리 확정
     if (fours >= 2) {
         score += SCORE_OPEN_FOUR;
@@ -180,34 +299,32 @@ static int evaluatePosition(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
     }
 
     // 위치 가중치
-    score += positionWeight[row][col];
+    score += positionWeight[idx];
 
+    PROF_END(PROF_EVAL_POSITION);
     return score;
 }
 
-// 보드 전체 평가
-int evaluateBoard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
+// 보드 전체 평가 (메일박스)
+int evaluateBoardMb(const unsigned char *mb, int aiColor) {
+    PROF_BEGIN(PROF_EVAL_BOARD);
     int score = 0;
-    int opponent = (aiColor == BLACK) ? WHITE : BLACK;
 
     for (int row = 0; row < BOARD_SIZE; row++) {
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            if (board[row][col] == EMPTY) continue;
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (mb[idx] == EMPTY) continue;
 
-            int color = board[row][col];
+            int color = mb[idx];
             int sign = (color == aiColor) ? 1 : -1;
 
             // 각 방향별 분석 (중복 방지: 시작점에서만)
             for (int dir = 0; dir < 4; dir++) {
                 // 이전 칸에 같은 색 돌이 있으면 스킵 (중복 계산 방지)
-                int px = col - DX[dir];
-                int py = row - DY[dir];
-                if (px >= 0 && px < BOARD_SIZE && py >= 0 && py < BOARD_SIZE) {
-                    if (board[py][px] == color) continue;
-                }
+                if (mb[idx - MB_DIR[dir]] == color) continue;
 
                 int count, openEnds;
-                analyzeLine(board, row, col, DX[dir], DY[dir], color, &count, &openEnds);
+                mbAnalyzeLine(mb, idx, MB_DIR[dir], color, &count, &openEnds);
 
                 int lineScore = 0;
                 if (count >= 5) {
@@ -227,18 +344,27 @@ int evaluateBoard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
             }
 
             // 위치 가중치
-            score += sign * positionWeight[row][col];
+            score += sign * positionWeight[idx];
         }
     }
 
+    PROF_END(PROF_EVAL_BOARD);
     return score;
 }
 
+// 보드 전체 평가
+int evaluateBoard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
+    unsigned char mb[MB_CELLS];
+    mbFromBoard(mb, board);
+    return evaluateBoardMb(mb, aiColor);
+}
+
 // 후보 수 구조체
 typedef struct {
     int row;
     int col;
     int score;
+    int threat;     // 위협 수 (전방 가지치기 제외, 탐색 노드에서만 채움)
 } ScoredMove;
 
 // 후보 수 비교 함수
@@ -246,32 +372,36 @@ static int compareMoves(const void *a, const void *b) {
     return ((ScoredMove*)b)->score - ((ScoredMove*)a)->score;
 }
 
-// 착수 가능한 위치 찾기
-int getPossibleMoves(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCount) {
-    int visited[BOARD_SIZE][BOARD_SIZE] = {0};
-    ScoredMove candidates[225];
+// 후보 점수 내림차순 정렬
+static void sortMoves(ScoredMove *moves, int count) {
+    PROF_BEGIN(PROF_SORT_MOVES);
+    qsort(moves, count, sizeof(ScoredMove), compareMoves);
+    PROF_END(PROF_SORT_MOVES);
+}
+
+// 돌 주변 range칸 이내 빈칸을 위치 가중치 순으로 반환 (벽 덕분에 범위 검사 없음)
+static int collectNearbyMoves(const unsigned char *mb, int range, Move moves[], int maxCount) {
+    PROF_BEGIN(PROF_GEN_MOVES);
+    unsigned char visited[MB_CELLS] = {0};
+    ScoredMove candidates[BOARD_SIZE * BOARD_SIZE];
     int candidateCount = 0;
     int hasStone = 0;
 
-    // 기존 돌 주변 2칸 이내만 탐색
     for (int row = 0; row < BOARD_SIZE; row++) {
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            if (board[row][col] != EMPTY) {
-                hasStone = 1;
-                for (int dr = -2; dr <= 2; dr++) {
-                    for (int dc = -2; dc <= 2; dc++) {
-                        int nr = row + dr;
-                        int nc = col + dc;
-                        if (nr >= 0 && nr < BOARD_SIZE && nc >= 0 && nc < BOARD_SIZE) {
-                            if (board[nr][nc] == EMPTY && !visited[nr][nc]) {
-                                visited[nr][nc] = 1;
-                                candidates[candidateCount].row = nr;
-                                candidates[candidateCount].col = nc;
-                                // 간단한 우선순위 (중앙에 가까울수록)
-                                candidates[candidateCount].score = positionWeight[nr][nc];
-                                candidateCount++;
-                            }
-                        }
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (mb[idx] == EMPTY) continue;
+            hasStone = 1;
+            for (int dr = -range; dr <= range; dr++) {
+                for (int dc = -range; dc <= range; dc++) {
+                    int n = idx + dr * MB_STRIDE + dc;
+                    if (mb[n] == EMPTY && !visited[n]) {
+                        visited[n] = 1;
+                        candidates[candidateCount].row = row + dr;
+                        candidates[candidateCount].col = col + dc;
+                        // 간단한 우선순위 (중앙에 가까울수록)
+                        candidates[candidateCount].score = positionWeight[n];
+                        candidateCount++;
                     }
                 }
             }
@@ -282,11 +412,12 @@ int getPossibleMoves(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCou
     if (!hasStone) {
         moves[0].row = BOARD_SIZE / 2;
         moves[0].col = BOARD_SIZE / 2;
+        PROF_END(PROF_GEN_MOVES);
         return 1;
     }
 
     // 정렬
-    qsort(candidates, candidateCount, sizeof(ScoredMove), compareMoves);
+    sortMoves(candidates, candidateCount);
 
     // 최대 개수만큼 반환
     int returnCount = (candidateCount < maxCount) ? candidateCount : maxCount;
@@ -295,43 +426,466 @@ int getPossibleMoves(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCou
         moves[i].col = candidates[i].col;
     }
 
+    PROF_END(PROF_GEN_MOVES);
     return returnCount;
 }
 
-// Alpha-Beta Pruning Minimax
-MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int beta,
-                   int isMaximizing, int aiColor) {
+// 착수 가능한 위치 찾기 (기존 돌 주변 2칸 이내)
+static int getPossibleMovesMb(const unsigned char *mb, Move moves[], int maxCount) {
+    return collectNearbyMoves(mb, 2, moves, maxCount);
+}
+
+int getPossibleMoves(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCount) {
+    unsigned char mb[MB_CELLS];
+    mbFromBoard(mb, board);
+    return getPossibleMovesMb(mb, moves, maxCount);
+}
+
+static _Thread_local int traceLastMove = -1;   // 트레이스용 마지막 착수 (row * BOARD_SIZE + col)
+
+// 탐색용 착수/무르기 (신경망 누산기 증분 갱신)
+static void makeMove(unsigned char *mb, int row, int col, int color) {
+    mb[MB_INDEX(row, col)] = (unsigned char)color;
+    traceLastMove = row * BOARD_SIZE + col;
+    searchHash ^= zobristKeys[color - 1][MB_INDEX(row, col)];
+    if (nnueActive) nnueAddStone(&searchAcc, row, col, color);
+    if (forbidRules) forbidUpdate(&searchForbid, mb, MB_INDEX(row, col));
+    if (mb == patternMb) patUpdate(&searchPatterns, mb, MB_INDEX(row, col));
+}
+
+static void unmakeMove(unsigned char *mb, int row, int col) {
+    int idx = MB_INDEX(row, col);
+    searchHash ^= zobristKeys[mb[idx] - 1][idx];
+    if (nnueActive) nnueRemoveStone(&searchAcc, row, col, mb[idx]);
+    mb[idx] = EMPTY;
+    if (forbidRules) forbidUpdate(&searchForbid, mb, idx);
+    if (mb == patternMb) patUpdate(&searchPatterns, mb, idx);
+}
+
+// 금수 맵을 현재 보드로 맞춤
+static void syncForbidMap(const unsigned char *mb) {
+    if (forbidRules == 0) return;
+    forbidInit(&searchForbid, BLACK, forbidRules);
+    forbidRebuild(&searchForbid, mb);
+}
+
+// 이번 탐색 보드의 패턴 보드 계산 (끝나면 patternMb = NULL)
+static void syncPatterns(const unsigned char *mb) {
+    patRebuild(&searchPatterns, mb);
+    patternMb = mb;
+}
+
+// color가 둘 수 없는 금수 자리를 후보에서 제거
+static int removeForbidden(Move moves[], int count, int color) {
+    if (forbidRules == 0 || color != BLACK) return count;
+
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (!forbidTest(&searchForbid, moves[i].row, moves[i].col)) {
+            moves[kept++] = moves[i];
+        }
+    }
+    return kept;
+}
+
+// 리프 평가: 신경망이 켜져 있으면 누산기로, 아니면 패턴 합산
+static int computeLeaf(const unsigned char *mb, int aiColor) {
+    if (nnueActive) return nnueEvaluate(&searchAcc, aiColor);
+    return evaluateBoardMb(mb, aiColor);
+}
+
+// 평가 캐시를 거친 리프 평가 (태그 최하위 비트는 1로 고정해 빈 항목과 구분)
+static int evaluateLeaf(const unsigned char *mb, int aiColor) {
+    if (!evalCacheActive) return computeLeaf(mb, aiColor);
+
+    unsigned long long key = searchHash ^ evalSalt[nnueActive][aiColor];
+    atomic_ullong *slot = &evalCache[key & (EVAL_CACHE_SIZE - 1)];
+    unsigned long long tag = (key >> 32) | 1;
+    unsigned long long entry = atomic_load_explicit(slot, memory_order_relaxed);
+
+    evalProbes++;
+    if ((entry >> 32) == tag) {
+        evalHits++;
+        return (int)(unsigned int)entry;
+    }
+
+    int score = computeLeaf(mb, aiColor);
+    atomic_store_explicit(slot, (tag << 32) | (unsigned int)score, memory_order_relaxed);
+    return score;
+}
+
+// 탐색 시작/종료: 누산기와 위치 해시를 현재 보드로 맞춤
+static void beginSearch(const unsigned char *mb) {
+    nnueActive = neuralEvalEnabled && nnueIsLoaded();
+    if (nnueActive) nnueRefresh(&searchAcc, mb);
+
+    searchHash = 0;
+    for (int idx = 0; idx < MB_CELLS; idx++) {
+        if (mb[idx] == BLACK || mb[idx] == WHITE) searchHash ^= zobristKeys[mb[idx] - 1][idx];
+    }
+    evalCacheActive = 1;
+}
+
+static void endSearch(void) {
+    nnueActive = 0;
+    evalCacheActive = 0;
+}
+
+// 분석 캐시는 기본 규칙 + 패턴 평가 결과만 공유 (신경망/금수 탐색 결과는 섞지 않음)
+static int useAnalysisCache(void) {
+    return anaCacheIsOpen() && !(neuralEvalEnabled && nnueIsLoaded()) && forbidRules == 0;
+}
+
+// 노드 예산(매 노드)과 하드 데드라인(1024 노드마다 시계 조회) 확인
+static int checkAbort(void) {
+    if (nodeLimit > 0 && searchNodes >= nodeLimit) {
+        searchAborted = 1;
+    }
+    if (clockActive && !searchAborted && (searchNodes & 1023) == 0 &&
+        tmHardExpired(&searchClock)) {
+        searchAborted = 1;
+    }
+    if (portfolio != NULL && !searchAborted && (searchNodes & 255) == 0 &&
+        atomic_load_explicit(&portfolio->ownWin, memory_order_relaxed)) {
+        searchAborted = 1;
+    }
+    return searchAborted;
+}
+
+// ============================================================
+// 탐색 트레이스 (trace.h): 노드를 나갈 때 레코드 하나, 트리는 후위 순서 + ply로 복원
+// 노드 함수는 본문(...Node)과 기록용 얇은 감싸개로 나눔 (꺼져 있으면 본문 바로 호출)
+// ============================================================
+
+#define TRACE_MAX_PLY 64
+
+static _Thread_local int tracePly = 0;          // 현재 노드 깊이 (루트 0)
+static _Thread_local signed char traceCutoff[TRACE_MAX_PLY];
+
+// 본문에서 컷(또는 즉시 승리)이 난 후보 순번 기록
+#define TRACE_CUT(i) do { \
+        if (traceOn && tracePly > 0 && tracePly <= TRACE_MAX_PLY) \
+            traceCutoff[tracePly - 1] = (signed char)(i); \
+    } while (0)
+
+// 노드 진입: 이 노드로 온 수(부모가 마지막으로 둔 수)를 돌려주고 ply를 늘림
+static int traceEnter(void) {
+    int move = (tracePly == 0) ? -1 : traceLastMove;
+    if (tracePly < TRACE_MAX_PLY) traceCutoff[tracePly] = -1;
+    tracePly++;
+    return move;
+}
+
+static void traceLeave(int kind, int move, int depth, int isMaximizing,
+                       int alpha, int beta, int score, int bestRow, int bestCol) {
+    TraceRecord record;
+
+    tracePly--;
+    record.alpha = alpha;
+    record.beta = beta;
+    record.score = score;
+    record.move = (short)move;
+    record.best = (short)((bestRow >= 0) ? bestRow * BOARD_SIZE + bestCol : -1);
+    record.ply = (unsigned char)tracePly;
+    record.depth = (signed char)depth;
+    record.cutoff = (tracePly < TRACE_MAX_PLY) ? traceCutoff[tracePly] : -1;
+    record.flags = (unsigned char)(kind | (isMaximizing ? TRACE_MAXIMIZING : 0) |
+                                   (searchAborted ? TRACE_ABORTED : 0));
+    traceWrite(&record);
+}
+
+// 탐색 하나의 시작 표시 (뷰어가 탐색별로 나눔)
+static void traceMark(int aiColor) {
+    TraceRecord record;
+
+    tracePly = 0;
+    if (!traceOn) return;
+    memset(&record, 0, sizeof(record));
+    record.move = (short)aiColor;
+    record.best = -1;
+    record.cutoff = -1;
+    record.flags = TRACE_MARK;
+    traceWrite(&record);
+}
+
+static int quiesce(unsigned char *mb, int alpha, int beta, int isMaximizing, int aiColor, int ply);
+static MoveResult searchMinimax(unsigned char *mb, int depth, int alpha, int beta,
+                                int isMaximizing, int aiColor);
+static MoveResult minimaxHard(unsigned char *mb, int depth, int alpha, int beta,
+                              int isMaximizing, int aiColor, int maxDepth);
+
+// ============================================================
+// 위협 정지 탐색: 깊이 0에서 5목, 4목과 그에 대한 강제 응수만 더 탐색
+// ============================================================
+
+#define QS_MAX_PLY 8                        // 정지 탐색 최대 깊이
+#define QS_NODE_CAP 64                      // 잎 하나당 정지 탐색 노드 상한
+#define QS_MAX_FOURS 16
+#define QS_WIN (INFINITY_SCORE - 50)        // 정지 탐색의 승리 (탐색 트리 안의 승리보다 낮게)
+
+static _Thread_local int qsBudget;
+
+static int isForbiddenFor(int color, int idx) {
+    return forbidRules && color == BLACK && forbidTest(&searchForbid, MB_ROW(idx), MB_COL(idx));
+}
+
+// 반환값은 다른 탐색과 같이 AI 관점 점수
+static int quiesceNode(unsigned char *mb, int alpha, int beta, int isMaximizing, int aiColor, int ply) {
+    int opponent = (aiColor == BLACK) ? WHITE : BLACK;
+    int color = isMaximizing ? aiColor : opponent;
+    int other = isMaximizing ? opponent : aiColor;
+    int sign = isMaximizing ? 1 : -1;
+    int fours[QS_MAX_FOURS];
+    int fourCount = 0;
+    int otherFives = 0;
+    int block = -1;
+
+    if (ply > 0) searchNodes++;     // ply 0은 부른 잎 노드로 이미 셈
+    qsBudget--;
+    if (checkAbort()) return 0;
+
+    // 한 번 훑어서 내 5목, 상대 5목 자리(막아야 할 곳), 내 4목 수를 모음
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (mb[idx] != EMPTY) continue;
+
+            unsigned char mineLocal[4], theirsLocal[4];
+            const unsigned char *mine = cellCodes(mb, idx, color, mineLocal);
+            const unsigned char *theirs = cellCodes(mb, idx, other, theirsLocal);
+            int four = 0;
+            int theirFive = 0;
+            for (int dir = 0; dir < 4; dir++) {
+                if (mine[dir] == PAT_FIVE) return sign * (QS_WIN - ply);
+                if (PAT_COUNT(mine[dir]) == 4 && PAT_OPEN(mine[dir]) > 0) four = 1;
+                if (theirs[dir] == PAT_FIVE) theirFive = 1;
+            }
+            if (theirFive) {
+                otherFives++;
+                block = idx;
+            }
+            if (four && fourCount < QS_MAX_FOURS && !isForbiddenFor(color, idx)) {
+                fours[fourCount++] = idx;
+            }
+        }
+    }
+
+    // 상대 5목이 둘 이상이거나 막을 자리가 금수면 패배
+    if (otherFives >= 2 || (otherFives == 1 && isForbiddenFor(color, block))) {
+        return -sign * (QS_WIN - ply - 1);
+    }
+
+    // 상대 5목 하나: 막는 수만 탐색 (제자리 평가 없음)
+    if (otherFives == 1) {
+        if (ply >= QS_MAX_PLY || qsBudget <= 0) return evaluateLeaf(mb, aiColor);
+        makeMove(mb, MB_ROW(block), MB_COL(block), color);
+        int score = quiesce(mb, alpha, beta, !isMaximizing, aiColor, ply + 1);
+        unmakeMove(mb, MB_ROW(block), MB_COL(block));
+        return score;
+    }
+
+    // 제자리 평가 (4목을 두지 않는 선택)
+    int best = evaluateLeaf(mb, aiColor);
+    if (fourCount == 0 || ply >= QS_MAX_PLY || qsBudget <= 0) return best;
+
+    if (isMaximizing) {
+        if (best >= beta) return best;
+        if (best > alpha) alpha = best;
+    } else {
+        if (best <= alpha) return best;
+        if (best < beta) beta = best;
+    }
+
+    for (int i = 0; i < fourCount; i++) {
+        makeMove(mb, MB_ROW(fours[i]), MB_COL(fours[i]), color);
+        int score = quiesce(mb, alpha, beta, !isMaximizing, aiColor, ply + 1);
+        unmakeMove(mb, MB_ROW(fours[i]), MB_COL(fours[i]));
+        if (searchAborted) return best;
+
+        if (isMaximizing) {
+            if (score > best) best = score;
+            if (best > alpha) alpha = best;
+        } else {
+            if (score < best) best = score;
+            if (best < beta) beta = best;
+        }
+        if (beta <= alpha) {
+            TRACE_CUT(i);
+            break;
+        }
+    }
+    return best;
+}
+
+static int quiesce(unsigned char *mb, int alpha, int beta, int isMaximizing, int aiColor, int ply) {
+    if (!traceOn) return quiesceNode(mb, alpha, beta, isMaximizing, aiColor, ply);
+
+    int move = traceEnter();
+    int score = quiesceNode(mb, alpha, beta, isMaximizing, aiColor, ply);
+    traceLeave(TRACE_QUIESCE, move, -ply, isMaximizing, alpha, beta, score, -1, -1);
+    return score;
+}
+
+// 잎 노드 값: 정지 탐색 (잎마다 노드 상한을 새로 줌)
+static int leafScore(unsigned char *mb, int alpha, int beta, int isMaximizing, int aiColor) {
+    PROF_BEGIN(PROF_LEAF);
+    qsBudget = QS_NODE_CAP;
+    int score = quiesce(mb, alpha, beta, isMaximizing, aiColor, 0);
+    PROF_END(PROF_LEAF);
+    return score;
+}
+
+// ============================================================
+// 전방 가지치기 (남은 깊이 1, 2)
+// 정적 평가(평가 캐시)가 창에서 여유 이상 벗어나 있으면 위협이 아닌 수로는 결과가 뒤집히지 않는다고 본다.
+//  - futility: 둘 차례 쪽에 불리하게 벗어나면 조용한 수를 건너뜀 (첫 수와 위협 수는 탐색)
+//  - 정적 컷: 유리하게 벗어나면 펼치지 않고 반환
+// 어느 쪽이든 4를 만들 자리가 있는 국면(4나 3이 있어 강제 수순이 걸린 국면)에서는 둘 다 하지 않는다.
+// 정적 평가는 몇 수 안의 승패를 모르므로, 거기서 자르면 프런티어의 필승/필수 방어를 놓친다.
+// ============================================================
+
+#define FUTILITY_DEPTH 2
+#define THREAT_ATTACK SCORE_OPEN_THREE      // 열린 3 이상을 만드는 수
+#define THREAT_DEFENSE SCORE_FOUR           // 상대가 4 이상(또는 쌍삼)을 만들 자리를 막는 수
+#define THREAT_FORCING SCORE_FOUR           // 둘 차례/상대 어느 쪽이든 4 이상(또는 쌍삼)을 만드는 자리
+
+static const int futilityMargin[FUTILITY_DEPTH + 1] = {0, SCORE_THREE * 3, SCORE_OPEN_THREE};
+
+// 정렬한 후보의 위협 표시, 어느 쪽이든 강제 수가 있는 국면이면 1
+static int markThreats(ScoredMove moves[], const int attack[], const int defense[], int count) {
+    int forcing = 0;
+    for (int i = 0; i < count; i++) {
+        moves[i].threat = attack[i] >= THREAT_ATTACK || defense[i] >= THREAT_DEFENSE;
+        if (attack[i] >= THREAT_FORCING || defense[i] >= THREAT_FORCING) forcing = 1;
+    }
+    return forcing;
+}
+
+// 전방 가지치기 판정: 정적 컷이면 *cutScore에 반환값을 넣고 -1,
+// futility면 조용한 수의 상한(최대화)/하한(최소화)을 *cutScore에 넣고 1, 아니면 0
+static int frontierPrune(const unsigned char *mb, int depth, int alpha, int beta,
+                         int isMaximizing, int aiColor, int forcing, int *cutScore) {
+    if (depth > FUTILITY_DEPTH || forcing) return 0;
+
+    int staticScore = evaluateLeaf(mb, aiColor);
+    int margin = futilityMargin[depth];
+
+    if (isMaximizing) {
+        if (staticScore - margin >= beta) {
+            *cutScore = staticScore - margin;
+            return -1;
+        }
+        if (staticScore + margin <= alpha) {
+            *cutScore = staticScore + margin;
+            return 1;
+        }
+    } else {
+        if (staticScore + margin <= alpha) {
+            *cutScore = staticScore + margin;
+            return -1;
+        }
+        if (staticScore - margin >= beta) {
+            *cutScore = staticScore - margin;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Alpha-Beta Pruning Minimax (메일박스 보드 위에서 착수/무르기)
+// 깊이 우선 교체 (같은 국면이면 항상 갱신)
+static void ttStore(unsigned long long key, int depth, int score, int flag, int move) {
+    TTEntry *entry = &transTable[key & (TT_SIZE - 1)];
+    if (entry->key != key && entry->depth > depth) return;
+    entry->key = key;
+    entry->score = score;
+    entry->move = (short)move;
+    entry->depth = (signed char)depth;
+    entry->flag = (unsigned char)flag;
+}
+
+static MoveResult searchMinimaxNode(unsigned char *mb, int depth, int alpha, int beta,
+                                    int isMaximizing, int aiColor) {
     MoveResult result = {0, -1, -1};
     int opponent = (aiColor == BLACK) ? WHITE : BLACK;
     int currentColor = isMaximizing ? aiColor : opponent;
 
-    // 기저 조건: 깊이 0
+    searchNodes++;
+    if (checkAbort()) return result;
+
+    // 기저 조건: 깊이 0 (정지 탐색)
     if (depth == 0) {
-        result.score = evaluateBoard(board, aiColor);
+        result.score = leafScore(mb, alpha, beta, isMaximizing, aiColor);
         return result;
     }
 
+    // 치환표: 충분히 깊은 기록이면 바로 반환, 아니면 그 수를 먼저 탐색
+    int alphaOrig = alpha;
+    int betaOrig = beta;
+    unsigned long long ttKey = 0;
+    int ttMove = -1;
+    if (ttActive) {
+        ttKey = searchHash ^ (isMaximizing ? zobristMax : 0);
+        TTEntry *entry = &transTable[ttKey & (TT_SIZE - 1)];
+        if (entry->key == ttKey && entry->move >= 0) {
+            ttMove = entry->move;
+            if (entry->depth >= depth &&
+                (entry->flag == TT_EXACT ||
+                 (entry->flag == TT_LOWER && entry->score >= beta) ||
+                 (entry->flag == TT_UPPER && entry->score <= alpha))) {
+                result.score = entry->score;
+                result.row = MB_ROW(ttMove);
+                result.col = MB_COL(ttMove);
+                return result;
+            }
+        }
+    }
+
     // 후보 수 가져오기
     Move moves[MAX_MOVES];
-    int moveCount = getPossibleMoves(board, moves, MAX_MOVES);
+    int moveCount = getPossibleMovesMb(mb, moves, MAX_MOVES);
+    moveCount = removeForbidden(moves, moveCount, currentColor);
 
     if (moveCount == 0) {
-        result.score = evaluateBoard(board, aiColor);
+        result.score = evaluateLeaf(mb, aiColor);
         return result;
     }
 
     // 후보 수 점수 매기기 및 정렬 (move ordering)
     ScoredMove scoredMoves[MAX_MOVES];
+    int attack[MAX_MOVES], defense[MAX_MOVES];
     for (int i = 0; i < moveCount; i++) {
         scoredMoves[i].row = moves[i].row;
         scoredMoves[i].col = moves[i].col;
         // 공격/방어 점수 합산
-        int attackScore = evaluatePosition(board, moves[i].row, moves[i].col, currentColor);
-        int defenseScore = evaluatePosition(board, moves[i].row, moves[i].col,
-                                           (currentColor == BLACK) ? WHITE : BLACK);
-        scoredMoves[i].score = attackScore + defenseScore;
+        attack[i] = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), currentColor);
+        defense[i] = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col),
+                                      (currentColor == BLACK) ? WHITE : BLACK);
+        scoredMoves[i].score = attack[i] + defense[i];
+    }
+    int forcing = markThreats(scoredMoves, attack, defense, moveCount);
+    sortMoves(scoredMoves, moveCount);
+
+    int futilityScore = 0;
+    int futile = frontierPrune(mb, depth, alpha, beta, isMaximizing, aiColor, forcing,
+                               &futilityScore);
+    if (futile < 0) {
+        result.score = futilityScore;
+        result.row = scoredMoves[0].row;
+        result.col = scoredMoves[0].col;
+        return result;
+    }
+
+    if (ttMove >= 0) {
+        for (int i = 1; i < moveCount; i++) {
+            if (MB_INDEX(scoredMoves[i].row, scoredMoves[i].col) == ttMove) {
+                ScoredMove first = scoredMoves[i];
+                memmove(&scoredMoves[1], &scoredMoves[0], i * sizeof(ScoredMove));
+                scoredMoves[0] = first;
+                break;
+            }
+        }
     }
-    qsort(scoredMoves, moveCount, sizeof(ScoredMove), compareMoves);
 
     // 깊이에 따라 후보 수 제한 (성능 최적화)
     // 참고: 어려움 모드는 minimaxHard에서 별도로 처리
@@ -350,19 +904,27 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
             int row = scoredMoves[i].row;
             int col = scoredMoves[i].col;
 
-            board[row][col] = aiColor;
+            // futility: 조용한 수는 상한만 반영하고 건너뜀
+            if (futile && i > 0 && !scoredMoves[i].threat) {
+                if (futilityScore > result.score) result.score = futilityScore;
+                continue;
+            }
+
+            makeMove(mb, row, col, aiColor);
 
             // 승리 체크
-            if (checkWinBoard(board, row, col, aiColor)) {
-                board[row][col] = EMPTY;
-                result.score = INFINITY_SCORE - (10 - depth);  // 빠른 승리 우선
+            if (mbCheckWin(mb, MB_INDEX(row, col), aiColor)) {
+                unmakeMove(mb, row, col);
+                TRACE_CUT(i);
+                result.score = MINIMAX_WIN_SCORE(depth);  // 빠른 승리 우선
                 result.row = row;
                 result.col = col;
                 return result;
             }
 
-            MoveResult child = minimax(board, depth - 1, alpha, beta, 0, aiColor);
-            board[row][col] = EMPTY;
+            MoveResult child = searchMinimax(mb, depth - 1, alpha, beta, 0, aiColor);
+            unmakeMove(mb, row, col);
+            if (searchAborted) return result;
 
             if (child.score > result.score) {
                 result.score = child.score;
@@ -375,6 +937,7 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
             }
 
             if (beta <= alpha) {
+                TRACE_CUT(i);
                 break;  // Pruning
             }
         }
@@ -385,19 +948,26 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
             int row = scoredMoves[i].row;
             int col = scoredMoves[i].col;
 
-            board[row][col] = opponent;
+            if (futile && i > 0 && !scoredMoves[i].threat) {
+                if (futilityScore < result.score) result.score = futilityScore;
+                continue;
+            }
+
+            makeMove(mb, row, col, opponent);
 
             // 상대 승리 체크
-            if (checkWinBoard(board, row, col, opponent)) {
-                board[row][col] = EMPTY;
-                result.score = -INFINITY_SCORE + (10 - depth);
+            if (mbCheckWin(mb, MB_INDEX(row, col), opponent)) {
+                unmakeMove(mb, row, col);
+                TRACE_CUT(i);
+                result.score = -MINIMAX_WIN_SCORE(depth);
                 result.row = row;
                 result.col = col;
                 return result;
             }
 
-            MoveResult child = minimax(board, depth - 1, alpha, beta, 1, aiColor);
-            board[row][col] = EMPTY;
+            MoveResult child = searchMinimax(mb, depth - 1, alpha, beta, 1, aiColor);
+            unmakeMove(mb, row, col);
+            if (searchAborted) return result;
 
             if (child.score < result.score) {
                 result.score = child.score;
@@ -410,82 +980,89 @@ MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int
             }
 
             if (beta <= alpha) {
+                TRACE_CUT(i);
                 break;  // Pruning
             }
         }
     }
 
+    if (ttActive) {
+        int flag = (result.score <= alphaOrig) ? TT_UPPER
+                 : (result.score >= betaOrig) ? TT_LOWER : TT_EXACT;
+        ttStore(ttKey, depth, result.score, flag, MB_INDEX(result.row, result.col));
+    }
+    return result;
+}
+
+static MoveResult searchMinimax(unsigned char *mb, int depth, int alpha, int beta,
+                                int isMaximizing, int aiColor) {
+    if (!traceOn) return searchMinimaxNode(mb, depth, alpha, beta, isMaximizing, aiColor);
+
+    int move = traceEnter();
+    MoveResult result = searchMinimaxNode(mb, depth, alpha, beta, isMaximizing, aiColor);
+    traceLeave(TRACE_MINIMAX, move, depth, isMaximizing, alpha, beta, result.score, result.row, result.col);
     return result;
 }
 
+MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int beta,
+                   int isMaximizing, int aiColor) {
+    unsigned char mb[MB_CELLS];
+    mbFromBoard(mb, board);
+    syncForbidMap(mb);
+    if (depth > MINIMAX_MAX_DEPTH) depth = MINIMAX_MAX_DEPTH;     // 승리 점수가 ±INFINITY_SCORE 안에 있도록
+    return searchMinimax(mb, depth, alpha, beta, isMaximizing, aiColor);
+}
+
 // ============================================================
 // 어려움 모드 전용: 완벽한 탐색을 위한 강화된 Minimax
 // ============================================================
 
 // 보드에서 특정 색상의 위협적인 패턴 찾기 (열린3, 4 등)
 // 반환: 막아야 할 위치들과 개수
-static int findThreats(int board[BOARD_SIZE][BOARD_SIZE], int color, Move threats[], int maxThreats) {
+int findThreats(const unsigned char *mb, int color, Move threats[], int maxThreats) {
     int threatCount = 0;
 
     for (int row = 0; row < BOARD_SIZE && threatCount < maxThreats; row++) {
         for (int col = 0; col < BOARD_SIZE && threatCount < maxThreats; col++) {
-            if (board[row][col] != color) continue;
+            int idx = MB_INDEX(row, col);
+            if (mb[idx] != color) continue;
 
             // 4방향 검사
             for (int dir = 0; dir < 4 && threatCount < maxThreats; dir++) {
-                int dx = DX[dir];
-                int dy = DY[dir];
+                int d = MB_DIR[dir];
 
                 // 이전 위치에 같은 색이 있으면 스킵 (중복 방지)
-                int px = col - dx;
-                int py = row - dy;
-                if (px >= 0 && px < BOARD_SIZE && py >= 0 && py < BOARD_SIZE) {
-                    if (board[py][px] == color) continue;
-                }
+                if (mb[idx - d] == color) continue;
 
                 // 연속 돌 세기
                 int count = 1;
-                int nx = col + dx;
-                int ny = row + dy;
-                while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == color) {
+                int p = idx + d;
+                while (mb[p] == color) {
                     count++;
-                    nx += dx;
-                    ny += dy;
+                    p += d;
                 }
 
                 // 3개 이상 연속일 때만 위협으로 간주
                 if (count >= 3) {
-                    // 정방향 끝 빈칸 확인
-                    if (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == EMPTY) {
-                        // 이미 추가된 위치인지 확인
-                        int duplicate = 0;
-                        for (int t = 0; t < threatCount; t++) {
-                            if (threats[t].row == ny && threats[t].col == nx) {
-                                duplicate = 1;
-                                break;
-                            }
-                        }
-                        if (!duplicate) {
-                            threats[threatCount].row = ny;
-                            threats[threatCount].col = nx;
-                            threatCount++;
-                        }
-                    }
+                    // 정방향 끝, 역방향 끝 빈칸 확인
+                    int ends[2] = {p, idx - d};
+                    for (int e = 0; e < 2 && threatCount < maxThreats; e++) {
+                        if (mb[ends[e]] != EMPTY) continue;
 
-                    // 역방향 끝 빈칸 확인
-                    int bx = col - dx;
-                    int by = row - dy;
-                    if (bx >= 0 && bx < BOARD_SIZE && by >= 0 && by < BOARD_SIZE && board[by][bx] == EMPTY) {
+                        int endRow = MB_ROW(ends[e]);
+                        int endCol = MB_COL(ends[e]);
+
+                        // 이미 추가된 위치인지 확인
                         int duplicate = 0;
                         for (int t = 0; t < threatCount; t++) {
-                            if (threats[t].row == by && threats[t].col == bx) {
+                            if (threats[t].row == endRow && threats[t].col == endCol) {
                                 duplicate = 1;
                                 break;
                             }
                         }
                         if (!duplicate) {
-                            threats[threatCount].row = by;
-                            threats[threatCount].col = bx;
+                            threats[threatCount].row = endRow;
+                            threats[threatCount].col = endCol;
                             threatCount++;
                         }
                     }
@@ -498,37 +1075,32 @@ static int findThreats(int board[BOARD_SIZE][BOARD_SIZE], int color, Move threat
 }
 
 // 특정 위치가 상대 위협을 막는 위치인지 확인하고 점수 반환
-static int getThreatBlockScore(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int opponentColor) {
-    if (board[row][col] != EMPTY) return 0;
+int getThreatBlockScore(const unsigned char *mb, int idx, int opponentColor) {
+    if (mb[idx] != EMPTY) return 0;
 
     int blockScore = 0;
 
     // 4방향 검사: 이 위치를 막으면 상대 라인이 끊어지는지 확인
     for (int dir = 0; dir < 4; dir++) {
-        int dx = DX[dir];
-        int dy = DY[dir];
+        int d = MB_DIR[dir];
 
         // 정방향으로 상대 돌 세기
         int forwardCount = 0;
-        int nx = col + dx;
-        int ny = row + dy;
-        while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == opponentColor) {
+        int p = idx + d;
+        while (mb[p] == opponentColor) {
             forwardCount++;
-            nx += dx;
-            ny += dy;
+            p += d;
         }
-        int forwardOpen = (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == EMPTY) ? 1 : 0;
+        int forwardOpen = (mb[p] == EMPTY) ? 1 : 0;
 
         // 역방향으로 상대 돌 세기
         int backwardCount = 0;
-        nx = col - dx;
-        ny = row - dy;
-        while (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == opponentColor) {
+        p = idx - d;
+        while (mb[p] == opponentColor) {
             backwardCount++;
-            nx -= dx;
-            ny -= dy;
+            p -= d;
         }
-        int backwardOpen = (nx >= 0 && nx < BOARD_SIZE && ny >= 0 && ny < BOARD_SIZE && board[ny][nx] == EMPTY) ? 1 : 0;
+        int backwardOpen = (mb[p] == EMPTY) ? 1 : 0;
 
         int totalCount = forwardCount + backwardCount;
         int totalOpen = forwardOpen + backwardOpen;
@@ -553,95 +1125,107 @@ static int getThreatBlockScore(int board[BOARD_SIZE][BOARD_SIZE], int row, int c
     return blockScore;
 }
 
-// 어려움 모드 전용 후보 수 찾기 (더 넓은 범위 탐색)
-static int getPossibleMovesHard(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCount) {
-    int visited[BOARD_SIZE][BOARD_SIZE] = {0};
-    ScoredMove candidates[225];
-    int candidateCount = 0;
-    int hasStone = 0;
+// 어려움 모드 전용 후보 수 찾기 (더 넓은 범위: 기존 돌 주변 3칸, 기본 모드는 2칸)
+int getPossibleMovesHard(const unsigned char *mb, Move moves[], int maxCount) {
+    return collectNearbyMoves(mb, 3, moves, maxCount);
+}
 
-    // 기존 돌 주변 3칸 이내 탐색 (기본 모드는 2칸)
-    for (int row = 0; row < BOARD_SIZE; row++) {
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            if (board[row][col] != EMPTY) {
-                hasStone = 1;
-                for (int dr = -3; dr <= 3; dr++) {
-                    for (int dc = -3; dc <= 3; dc++) {
-                        int nr = row + dr;
-                        int nc = col + dc;
-                        if (nr >= 0 && nr < BOARD_SIZE && nc >= 0 && nc < BOARD_SIZE) {
-                            if (board[nr][nc] == EMPTY && !visited[nr][nc]) {
-                                visited[nr][nc] = 1;
-                                candidates[candidateCount].row = nr;
-                                candidates[candidateCount].col = nc;
-                                candidates[candidateCount].score = positionWeight[nr][nc];
-                                candidateCount++;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+// 강제 수 연장: 4목을 만드는 수와 상대 4목에 대한 유일한 응수는 깊이를 쓰지 않음
+// (자식에 depth와 maxDepth를 같이 1 더 줘서 루트로부터의 거리 계산은 그대로)
+// 한 줄에서 쓴 연장 수 = maxDepth - 반복 심화 깊이, 이 값이 예산을 넘지 않게 함
+#define HARD_MAX_EXTENSIONS 4
 
-    // 보드가 비어있으면 중앙
-    if (!hasStone) {
-        moves[0].row = BOARD_SIZE / 2;
-        moves[0].col = BOARD_SIZE / 2;
-        return 1;
-    }
+static _Thread_local int hardNominalDepth = 0;
 
-    // 정렬
-    qsort(candidates, candidateCount, sizeof(ScoredMove), compareMoves);
+static int makesFive(const unsigned char *mb, int idx, int color) {
+    unsigned char local[4];
+    const unsigned char *codes = cellCodes(mb, idx, color, local);
+    for (int dir = 0; dir < 4; dir++) {
+        if (codes[dir] == PAT_FIVE) return 1;
+    }
+    return 0;
+}
 
-    // 최대 개수만큼 반환
-    int returnCount = (candidateCount < maxCount) ? candidateCount : maxCount;
-    for (int i = 0; i < returnCount; i++) {
-        moves[i].row = candidates[i].row;
-        moves[i].col = candidates[i].col;
+// fiveBlocks: 상대가 5목을 만들 자리 수 (1이면 그 자리를 막는 수만 강제 수)
+static int forcingMove(const unsigned char *mb, int idx, int color, int fiveBlocks) {
+    if (fiveBlocks == 1) {
+        return makesFive(mb, idx, (color == BLACK) ? WHITE : BLACK);
     }
 
-    return returnCount;
+    unsigned char local[4];
+    const unsigned char *codes = cellCodes(mb, idx, color, local);
+    for (int dir = 0; dir < 4; dir++) {
+        if (PAT_COUNT(codes[dir]) == 4 && PAT_OPEN(codes[dir]) > 0) return 1;
+    }
+    return 0;
 }
 
 // 어려움 모드 전용 Minimax: 더 깊고 넓은 탐색
-static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int beta,
-                              int isMaximizing, int aiColor, int maxDepth) {
+static MoveResult minimaxHardNode(unsigned char *mb, int depth, int alpha, int beta,
+                                  int isMaximizing, int aiColor, int maxDepth) {
     MoveResult result = {0, -1, -1};
     int opponent = (aiColor == BLACK) ? WHITE : BLACK;
     int currentColor = isMaximizing ? aiColor : opponent;
 
-    // 기저 조건: 깊이 0
+    searchNodes++;
+    if (checkAbort()) return result;
+
+    // 기저 조건: 깊이 0 (정지 탐색)
     if (depth == 0) {
-        result.score = evaluateBoard(board, aiColor);
+        result.score = leafScore(mb, alpha, beta, isMaximizing, aiColor);
         return result;
     }
 
     // 후보 수 가져오기 (어려움 모드 전용)
     Move moves[MAX_MOVES_HARD];
-    int moveCount = getPossibleMovesHard(board, moves, MAX_MOVES_HARD);
+    int moveCount = getPossibleMovesHard(mb, moves, MAX_MOVES_HARD);
+    moveCount = removeForbidden(moves, moveCount, currentColor);
 
     if (moveCount == 0) {
-        result.score = evaluateBoard(board, aiColor);
+        result.score = evaluateLeaf(mb, aiColor);
         return result;
     }
 
     // 후보 수 점수 매기기 및 정렬
     ScoredMove scoredMoves[MAX_MOVES_HARD];
+    int attack[MAX_MOVES_HARD], defense[MAX_MOVES_HARD];
+    int fiveBlocks = 0;
     for (int i = 0; i < moveCount; i++) {
         scoredMoves[i].row = moves[i].row;
         scoredMoves[i].col = moves[i].col;
-        int attackScore = evaluatePosition(board, moves[i].row, moves[i].col, currentColor);
-        int defenseScore = evaluatePosition(board, moves[i].row, moves[i].col,
-                                           (currentColor == BLACK) ? WHITE : BLACK);
+        attack[i] = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), currentColor);
+        defense[i] = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col),
+                                      (currentColor == BLACK) ? WHITE : BLACK);
         // 공격과 방어 모두 고려하되, 위협적인 수에 가중치 부여
-        scoredMoves[i].score = attackScore + defenseScore * 9 / 10;
+        scoredMoves[i].score = attack[i] + defense[i] * 9 / 10;
+        if (defense[i] >= SCORE_FIVE) fiveBlocks++;
+    }
+    int forcing = markThreats(scoredMoves, attack, defense, moveCount);
+
+    // 루트: 증명 스레드가 찾은 상대 VCF 수순의 칸을 먼저 (막는 수 후보)
+    int depthFromRoot = maxDepth - depth;
+    if (depthFromRoot == 0 && portfolio != NULL &&
+        atomic_load_explicit(&portfolio->opponentWin, memory_order_acquire)) {
+        for (int i = 0; i < moveCount; i++) {
+            if (portfolio->refute[MB_INDEX(scoredMoves[i].row, scoredMoves[i].col)]) {
+                scoredMoves[i].score += SCORE_OPEN_FOUR;
+            }
+        }
+    }
+    sortMoves(scoredMoves, moveCount);
+
+    int futilityScore = 0;
+    int futile = frontierPrune(mb, depth, alpha, beta, isMaximizing, aiColor, forcing,
+                               &futilityScore);
+    if (futile < 0) {
+        result.score = futilityScore;
+        result.row = scoredMoves[0].row;
+        result.col = scoredMoves[0].col;
+        return result;
     }
-    qsort(scoredMoves, moveCount, sizeof(ScoredMove), compareMoves);
 
     // 어려움 모드: 깊이에 따라 더 많은 후보 탐색
     int maxMoves = moveCount;
-    int depthFromRoot = maxDepth - depth;
     if (depthFromRoot == 0) {
         // 루트: 모든 유망한 후보 탐색
         maxMoves = (moveCount < 50) ? moveCount : 50;
@@ -655,8 +1239,22 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
         maxMoves = (moveCount < 12) ? moveCount : 12;
     }
 
+    // 상대 4목: 내 5목이나 막는 수(정렬상 맨 앞) 말고는 바로 지므로 한 수만 탐색
+    if (fiveBlocks > 0) {
+        for (int i = 1; i < moveCount; i++) {
+            if (makesFive(mb, MB_INDEX(scoredMoves[i].row, scoredMoves[i].col), currentColor)) {
+                ScoredMove win = scoredMoves[i];
+                scoredMoves[i] = scoredMoves[0];
+                scoredMoves[0] = win;
+                break;
+            }
+        }
+        maxMoves = 1;
+    }
+
     result.row = scoredMoves[0].row;
     result.col = scoredMoves[0].col;
+    int canExtend = maxDepth - hardNominalDepth < HARD_MAX_EXTENSIONS;
 
     if (isMaximizing) {
         result.score = -INFINITY_SCORE;
@@ -665,19 +1263,28 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
             int row = scoredMoves[i].row;
             int col = scoredMoves[i].col;
 
-            board[row][col] = aiColor;
+            // futility: 조용한 수는 상한만 반영하고 건너뜀
+            if (futile && i > 0 && !scoredMoves[i].threat) {
+                if (futilityScore > result.score) result.score = futilityScore;
+                continue;
+            }
+
+            int ext = canExtend && forcingMove(mb, MB_INDEX(row, col), aiColor, fiveBlocks);
+            makeMove(mb, row, col, aiColor);
 
             // 승리 체크
-            if (checkWinBoard(board, row, col, aiColor)) {
-                board[row][col] = EMPTY;
+            if (mbCheckWin(mb, MB_INDEX(row, col), aiColor)) {
+                unmakeMove(mb, row, col);
+                TRACE_CUT(i);
                 result.score = INFINITY_SCORE - (maxDepth - depth);
                 result.row = row;
                 result.col = col;
                 return result;
             }
 
-            MoveResult child = minimaxHard(board, depth - 1, alpha, beta, 0, aiColor, maxDepth);
-            board[row][col] = EMPTY;
+            MoveResult child = minimaxHard(mb, depth - 1 + ext, alpha, beta, 0, aiColor, maxDepth + ext);
+            unmakeMove(mb, row, col);
+            if (searchAborted) return result;
 
             if (child.score > result.score) {
                 result.score = child.score;
@@ -690,6 +1297,7 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
             }
 
             if (beta <= alpha) {
+                TRACE_CUT(i);
                 break;
             }
         }
@@ -700,19 +1308,27 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
             int row = scoredMoves[i].row;
             int col = scoredMoves[i].col;
 
-            board[row][col] = opponent;
+            if (futile && i > 0 && !scoredMoves[i].threat) {
+                if (futilityScore < result.score) result.score = futilityScore;
+                continue;
+            }
+
+            int ext = canExtend && forcingMove(mb, MB_INDEX(row, col), opponent, fiveBlocks);
+            makeMove(mb, row, col, opponent);
 
             // 상대 승리 체크
-            if (checkWinBoard(board, row, col, opponent)) {
-                board[row][col] = EMPTY;
+            if (mbCheckWin(mb, MB_INDEX(row, col), opponent)) {
+                unmakeMove(mb, row, col);
+                TRACE_CUT(i);
                 result.score = -INFINITY_SCORE + (maxDepth - depth);
                 result.row = row;
                 result.col = col;
                 return result;
             }
 
-            MoveResult child = minimaxHard(board, depth - 1, alpha, beta, 1, aiColor, maxDepth);
-            board[row][col] = EMPTY;
+            MoveResult child = minimaxHard(mb, depth - 1 + ext, alpha, beta, 1, aiColor, maxDepth + ext);
+            unmakeMove(mb, row, col);
+            if (searchAborted) return result;
 
             if (child.score < result.score) {
                 result.score = child.score;
@@ -725,6 +1341,7 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
             }
 
             if (beta <= alpha) {
+                TRACE_CUT(i);
                 break;
             }
         }
@@ -733,23 +1350,117 @@ static MoveResult minimaxHard(int board[BOARD_SIZE][BOARD_SIZE], int depth, int
     return result;
 }
 
+static MoveResult minimaxHard(unsigned char *mb, int depth, int alpha, int beta,
+                              int isMaximizing, int aiColor, int maxDepth) {
+    if (!traceOn) return minimaxHardNode(mb, depth, alpha, beta, isMaximizing, aiColor, maxDepth);
+
+    int move = traceEnter();
+    MoveResult result = minimaxHardNode(mb, depth, alpha, beta, isMaximizing, aiColor, maxDepth);
+    traceLeave(TRACE_HARD, move, depth, isMaximizing, alpha, beta, result.score, result.row, result.col);
+    return result;
+}
+
+// 깊이 depth 탐색 한 번 (hard: minimaxHard)
+static MoveResult searchDepth(unsigned char *mb, int aiColor, int depth, int hard) {
+    if (hard) {
+        hardNominalDepth = depth;
+        return minimaxHard(mb, depth, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor, depth);
+    }
+    return searchMinimax(mb, depth, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor);
+}
+
+// 노드 예산 안에서 maxDepth까지 반복 심화
+// (노드 예산이나 하드 데드라인에 걸려 중단된 반복의 결과는 버림. 단 깊이 1이 중단되면
+//  그때까지 끝까지 본 루트 수 중 최선, 하나도 없으면 정렬 첫 수를 씀. *depthDone은 0)
+static MoveResult runSearch(unsigned char *mb, int aiColor, int maxDepth,
+                            int hard, int *depthDone) {
+    MoveResult best = {0, -1, -1};
+    long long lastIterNodes = 0;
+
+    *depthDone = 0;
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        long long iterStart = tmNowMs();
+        long long nodesBefore = searchNodes;
+        MoveResult result = searchDepth(mb, aiColor, depth, hard);
+        if (searchAborted) {
+            if (depth == 1) best = result;
+            break;
+        }
+
+        best = result;
+        *depthDone = depth;
+
+        // 승패가 확정되면 더 볼 필요 없음
+        if (result.score >= INFINITY_SCORE - 100 || result.score <= -INFINITY_SCORE + 100) break;
+
+        // 다음 반복이 노드 예산 안에 못 끝날 것 같으면 여기서 멈춤
+        if (!tmNodesAllowNext(searchNodes, searchNodes - nodesBefore, &lastIterNodes, nodeLimit)) break;
+
+        if (!tmNextIteration(&searchClock, result.row * BOARD_SIZE + result.col,
+                             (int)(tmNowMs() - iterStart))) {
+            break;
+        }
+    }
+    return best;
+}
+
 // 어려움 모드 전용: 위협 분석 및 최적 수 찾기
-static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
+static int cpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+// 증명 스레드: 내 VCF, 없으면 (내가 한 수 쉰다고 보고) 상대 VCF
+static void *portfolioWorker(void *arg) {
+    Portfolio *pf = (Portfolio*)arg;
+    int opponent = (pf->aiColor == BLACK) ? WHITE : BLACK;
+    VcfResult vcf;
+
+    if (vcfSolve(pf->mb, pf->aiColor, pf->rules, PORTFOLIO_MAX_FOURS, PORTFOLIO_NODE_CAP,
+                 &pf->stop, &vcf)) {
+        pf->winMove = vcf.line[0];
+        atomic_store_explicit(&pf->ownWin, 1, memory_order_release);
+        return NULL;
+    }
+    if (atomic_load_explicit(&pf->stop, memory_order_relaxed)) return NULL;
+
+    if (vcfSolve(pf->mb, opponent, pf->rules, PORTFOLIO_MAX_FOURS, PORTFOLIO_NODE_CAP,
+                 &pf->stop, &vcf)) {
+        for (int i = 0; i < vcf.length; i++) {
+            pf->refute[MB_INDEX(vcf.line[i].row, vcf.line[i].col)] = 1;
+        }
+        atomic_store_explicit(&pf->opponentWin, 1, memory_order_release);
+    }
+    return NULL;
+}
+
+static Move findBestMoveHard(unsigned char *mb, int aiColor) {
     int opponent = (aiColor == BLACK) ? WHITE : BLACK;
 
     // 후보 수 가져오기 (넓은 범위)
     Move moves[MAX_MOVES_HARD];
-    int moveCount = getPossibleMovesHard(board, moves, MAX_MOVES_HARD);
+    int moveCount = getPossibleMovesHard(mb, moves, MAX_MOVES_HARD);
+    moveCount = removeForbidden(moves, moveCount, aiColor);
 
     if (moveCount == 0) {
         Move center = {BOARD_SIZE / 2, BOARD_SIZE / 2};
         return center;
     }
 
+    // 양쪽 위협 맵: 5목 자리, 열린4/쌍사 자리를 보드 전체에서 한 번에 (evaluatePosition 임계값과 같음)
+    ThreatMap own, theirs;
+    bbThreatMap(mb, aiColor, &own);
+    bbThreatMap(mb, opponent, &theirs);
+
     // === 1단계: 즉시 승리 확인 ===
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
-        if (score >= SCORE_FIVE) {
+        if (bbTest(&own.five, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
@@ -757,27 +1468,26 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
     // === 2단계: 상대 즉시 승리 방어 (4연속 막기) ===
     // 먼저 직접 위협 탐지로 확인
     Move threats[20];
-    int threatCount = findThreats(board, opponent, threats, 20);
+    int threatCount = findThreats(mb, opponent, threats, 20);
+    threatCount = removeForbidden(threats, threatCount, aiColor);
     for (int t = 0; t < threatCount; t++) {
         // 이 위치가 4연속을 막는지 확인
-        int blockScore = getThreatBlockScore(board, threats[t].row, threats[t].col, opponent);
+        int blockScore = getThreatBlockScore(mb, MB_INDEX(threats[t].row, threats[t].col), opponent);
         if (blockScore >= SCORE_FIVE) {
             return threats[t];
         }
     }
 
-    // evaluatePosition으로도 확인
+    // 위협 맵으로도 확인
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, opponent);
-        if (score >= SCORE_FIVE) {
+        if (bbTest(&theirs.five, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
 
-    // === 3단계: 승리 확정 수 (열린4, 쌍사, 사삼) ===
+    // === 3단계: 승리 확정 수 (열린4, 쌍사) ===
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
-        if (score >= SCORE_OPEN_FOUR) {
+        if (bbTest(&own.win, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
@@ -788,7 +1498,7 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
 
     // 위협 위치에서 막기 점수 계산
     for (int t = 0; t < threatCount; t++) {
-        int blockScore = getThreatBlockScore(board, threats[t].row, threats[t].col, opponent);
+        int blockScore = getThreatBlockScore(mb, MB_INDEX(threats[t].row, threats[t].col), opponent);
         if (blockScore >= SCORE_OPEN_FOUR) {
             // 열린4 막기 = 즉시 방어
             return threats[t];
@@ -804,8 +1514,7 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
     if (bestBlockScore >= SCORE_FOUR && bestBlockIdx >= 0) {
         // 공격으로 더 좋은 수가 있는지 확인
         for (int i = 0; i < moveCount; i++) {
-            int attackScore = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
-            if (attackScore >= SCORE_OPEN_FOUR) {
+            if (bbTest(&own.win, moves[i].row, moves[i].col)) {
                 return moves[i];
             }
         }
@@ -820,9 +1529,9 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
 
     for (int i = 0; i < moveCount; i++) {
         // 방어 점수 (상대가 이 위치에 두면 얻는 점수)
-        int defScore = evaluatePosition(board, moves[i].row, moves[i].col, opponent);
+        int defScore = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), opponent);
         // 직접 위협 막기 점수도 추가
-        int blockScore = getThreatBlockScore(board, moves[i].row, moves[i].col, opponent);
+        int blockScore = getThreatBlockScore(mb, MB_INDEX(moves[i].row, moves[i].col), opponent);
         defScore = (defScore > blockScore) ? defScore : blockScore;
 
         if (defScore > bestDefenseScore) {
@@ -831,7 +1540,7 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
         }
 
         // 공격 점수
-        int attackScore = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
+        int attackScore = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), aiColor);
         if (attackScore > bestAttackScore) {
             bestAttackScore = attackScore;
             bestAttackIdx = i;
@@ -866,12 +1575,62 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
         }
     }
 
-    // === 9단계: 깊은 Minimax 탐색 ===
-    int depth = 8;
-    MoveResult result = minimaxHard(board, depth, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor, depth);
+    // === 9단계: 깊은 탐색 (MCTS 또는 Minimax) ===
+    if (searchEngine == ENGINE_MCTS) {
+        MctsStats stats;
+        int budgetMs = (turnTimeMs > 0) ? tmSoftRemaining(&searchClock) : searchTimeBudgetMs;
+        Move mctsMove = mctsSearch(mb, aiColor, budgetMs > 0 ? budgetMs : 1);
+        mctsGetStats(&stats);
+        searchNodes = stats.playouts;
+        // MCTS는 금수를 모르므로 금수 자리면 Alpha-Beta로 대체
+        if (mctsMove.row >= 0 && mctsMove.col >= 0 &&
+            !(forbidRules && aiColor == BLACK && forbidTest(&searchForbid, mctsMove.row, mctsMove.col))) {
+            return mctsMove;
+        }
+    }
+
+    AnaEntry cached;
+    if (useAnalysisCache() &&
+        anaCacheLookup(mb, aiColor, ANA_SEARCH_HARD, searchBudget->cacheDepth, &cached)) {
+        return cached.move;
+    }
+
+    // 포트폴리오: 본 탐색과 동시에 VCF 증명 (스레드를 못 만들면 본 탐색만)
+    Portfolio *pf = NULL;
+    pthread_t solver;
+    int usePortfolio = (portfolioMode >= 0) ? portfolioMode : (cpuCount() >= 2);
+    if (usePortfolio && (pf = (Portfolio*)calloc(1, sizeof(Portfolio))) != NULL) {
+        memcpy(pf->mb, mb, MB_CELLS);
+        pf->aiColor = aiColor;
+        pf->rules = forbidRules;
+        if (pthread_create(&solver, NULL, portfolioWorker, pf) != 0) {
+            free(pf);
+            pf = NULL;
+        }
+    }
+
+    int depthDone;
+    portfolio = pf;
+    beginSearch(mb);
+    MoveResult result = runSearch(mb, aiColor, searchBudget->maxDepth, 1, &depthDone);
+    endSearch();
+    portfolio = NULL;
+
+    if (pf != NULL) {
+        atomic_store(&pf->stop, 1);
+        pthread_join(solver, NULL);
+        int won = atomic_load_explicit(&pf->ownWin, memory_order_acquire);
+        Move winMove = pf->winMove;
+        free(pf);
+        // 증명된 승리 (본 탐색이 중간에 끊겼을 수 있으므로 캐시에 넣지 않음)
+        if (won) return winMove;
+    }
 
     if (result.row >= 0 && result.col >= 0) {
         Move bestMove = {result.row, result.col};
+        if (depthDone > 0 && useAnalysisCache()) {
+            anaCacheStore(mb, aiColor, ANA_SEARCH_HARD, depthDone, result.score, bestMove);
+        }
         return bestMove;
     }
 
@@ -883,61 +1642,57 @@ static Move findBestMoveHard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor) {
     return moves[0];
 }
 
-// AI 최적 착수 찾기
-Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty) {
-    if (!initialized) {
-        initAI();
-    }
-
-    // === 어려움 모드: 전용 함수 사용 (완벽한 탐색) ===
-    if (difficulty == HARD) {
-        return findBestMoveHard(board, aiColor);
-    }
-
+// 쉬움/보통 모드 최적 수 찾기
+static Move findBestMoveNormal(unsigned char *mb, int aiColor) {
     int opponent = (aiColor == BLACK) ? WHITE : BLACK;
 
     // 후보 수 가져오기
     Move moves[MAX_MOVES];
-    int moveCount = getPossibleMoves(board, moves, MAX_MOVES);
+    int moveCount = getPossibleMovesMb(mb, moves, MAX_MOVES);
+    moveCount = removeForbidden(moves, moveCount, aiColor);
 
     if (moveCount == 0) {
         Move center = {BOARD_SIZE / 2, BOARD_SIZE / 2};
         return center;
     }
 
+    // 양쪽 위협 맵 (1~4단계의 임계값 판정을 비트 검사로)
+    ThreatMap own, theirs;
+    bbThreatMap(mb, aiColor, &own);
+    bbThreatMap(mb, opponent, &theirs);
+
     // === 1단계: 즉시 승리 확인 ===
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
-        if (score >= SCORE_FIVE) {
+        if (bbTest(&own.five, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
 
     // === 2단계: 상대 즉시 승리 방어 ===
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, opponent);
-        if (score >= SCORE_FIVE) {
+        if (bbTest(&theirs.five, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
 
     // === 3단계: 승리 확정 수 (열린4, 쌍사) ===
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
-        if (score >= SCORE_OPEN_FOUR) {
+        if (bbTest(&own.win, moves[i].row, moves[i].col)) {
             return moves[i];
         }
     }
 
     // === 4단계: 상대 승리 확정 방어 ===
-    int bestDefenseIdx = -1;
-    int bestDefenseScore = 0;
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, opponent);
-        if (score >= SCORE_OPEN_FOUR) {
+        if (bbTest(&theirs.win, moves[i].row, moves[i].col)) {
             // 열린4 방어 필수
             return moves[i];
         }
+    }
+    int bestDefenseIdx = -1;
+    int bestDefenseScore = 0;
+    for (int i = 0; i < moveCount; i++) {
+        int score = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), opponent);
         if (score > bestDefenseScore) {
             bestDefenseScore = score;
             bestDefenseIdx = i;
@@ -949,11 +1704,11 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
         // 방어하면서 공격도 가능한지 확인
         int defRow = moves[bestDefenseIdx].row;
         int defCol = moves[bestDefenseIdx].col;
-        int defAttackScore = evaluatePosition(board, defRow, defCol, aiColor);
+        int defAttackScore = evaluatePosition(mb, MB_INDEX(defRow, defCol), aiColor);
 
         // 더 좋은 공격 수가 있는지 확인
         for (int i = 0; i < moveCount; i++) {
-            int attackScore = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
+            int attackScore = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), aiColor);
             if (attackScore >= SCORE_OPEN_FOUR) {
                 // 공격이 더 좋으면 공격 우선 (상대가 막아야 함)
                 return moves[i];
@@ -967,7 +1722,7 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
     int bestAttackIdx = -1;
     int bestAttackScore = 0;
     for (int i = 0; i < moveCount; i++) {
-        int score = evaluatePosition(board, moves[i].row, moves[i].col, aiColor);
+        int score = evaluatePosition(mb, MB_INDEX(moves[i].row, moves[i].col), aiColor);
         if (score > bestAttackScore) {
             bestAttackScore = score;
             bestAttackIdx = i;
@@ -988,27 +1743,23 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
         return moves[bestDefenseIdx];
     }
 
-    // === 7단계: Minimax 탐색 (쉬움/보통 모드) ===
-    int depth;
-    switch (difficulty) {
-        case EASY:
-            depth = 2;
-            // 30% 확률로 랜덤 선택
-            if (rand() % 100 < 30) {
-                int randIdx = rand() % ((moveCount < 5) ? moveCount : 5);
-                return moves[randIdx];
-            }
-            break;
-        case MEDIUM:
-        default:
-            depth = 4;
-            break;
+    // === 7단계: Minimax 탐색 (쉬움/보통 모드, 난이도 = 노드 예산) ===
+    int cacheable = (searchBudget->cacheDepth > 0) && useAnalysisCache();
+    AnaEntry cached;
+    if (cacheable && anaCacheLookup(mb, aiColor, ANA_SEARCH_MINIMAX, searchBudget->cacheDepth, &cached)) {
+        return cached.move;
     }
 
-    MoveResult result = minimax(board, depth, -INFINITY_SCORE, INFINITY_SCORE, 1, aiColor);
+    int depthDone;
+    beginSearch(mb);
+    MoveResult result = runSearch(mb, aiColor, searchBudget->maxDepth, 0, &depthDone);
+    endSearch();
 
     if (result.row >= 0 && result.col >= 0) {
         Move bestMove = {result.row, result.col};
+        if (cacheable && depthDone > 0) {
+            anaCacheStore(mb, aiColor, ANA_SEARCH_MINIMAX, depthDone, result.score, bestMove);
+        }
         return bestMove;
     }
 
@@ -1016,3 +1767,250 @@ Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty
     return moves[0];
 }
 
+// 이번 수의 시계 시작 (진행 단계 = 돌 수, 변동성 = 양쪽 위협 수)
+static void startClock(const unsigned char *mb, int aiColor, int turnMs) {
+    Move threats[20];
+    int opponent = (aiColor == BLACK) ? WHITE : BLACK;
+    int stones = 0;
+
+    searchAborted = 0;
+    clockActive = (turnMs > 0);
+    if (!clockActive) return;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (mb[MB_INDEX(row, col)] != EMPTY) stones++;
+        }
+    }
+    int threatCount = findThreats(mb, aiColor, threats, 20) + findThreats(mb, opponent, threats, 20);
+    tmStart(&searchClock, turnMs, stones, threatCount);
+}
+
+// AI 최적 착수 찾기
+Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty) {
+    if (!initialized) {
+        initAI();
+    }
+
+    searchNodes = 0;
+    evalProbes = evalHits = 0;
+    traceMark(aiColor);
+
+    // 탐색은 메일박스 사본 위에서 진행
+    unsigned char mb[MB_CELLS];
+    mbFromBoard(mb, board);
+    syncForbidMap(mb);
+    syncPatterns(mb);
+
+    // 난이도 예산: 노드 상한 + 시간 상한 (턴 시계가 있으면 시계가 시간 관리를 맡음)
+    searchBudget = &difficultyBudget[(difficulty >= EASY && difficulty <= HARD) ? difficulty : MEDIUM];
+    nodeLimit = searchBudget->nodes;
+    if (turnTimeMs > 0) {
+        startClock(mb, aiColor, turnTimeMs);
+    } else {
+        startClock(mb, aiColor, searchBudget->timeMs);
+        searchClock.softMs = searchClock.hardMs = searchBudget->timeMs;
+    }
+
+    // 어려움 모드는 전용 함수 사용 (완벽한 탐색)
+    Move best = (difficulty == HARD) ? findBestMoveHard(mb, aiColor)
+                                     : findBestMoveNormal(mb, aiColor);
+    clockActive = 0;
+    nodeLimit = 0;
+    patternMb = NULL;
+    return best;
+}
+
+
+// ============================================================
+// 다중 PV 분석 (힌트, 복기, 통계용)
+// ============================================================
+
+#define ANALYSIS_DEPTH 4        // 시간 예산이 없을 때 (보통 난이도와 같은 깊이)
+#define ANALYSIS_ROOT_MOVES 20
+
+// 이미 보고한 수(lines[0..excluded-1])를 뺀 루트 최선 수
+// 루트마다 전체 창에서 시작하므로 반환 점수는 정확한 값
+static MoveResult searchRootExcludingNode(unsigned char *mb, int aiColor, int depth,
+                                          const Move rootMoves[], int rootCount,
+                                          const PvLine lines[], int excluded) {
+    MoveResult best = {-INFINITY_SCORE - 1, -1, -1};
+    int alpha = -INFINITY_SCORE;
+
+    for (int i = 0; i < rootCount; i++) {
+        int row = rootMoves[i].row;
+        int col = rootMoves[i].col;
+        int skip = 0;
+        for (int j = 0; j < excluded; j++) {
+            if (lines[j].move.row == row && lines[j].move.col == col) skip = 1;
+        }
+        if (skip) continue;
+
+        int score;
+        makeMove(mb, row, col, aiColor);
+        if (mbCheckWin(mb, MB_INDEX(row, col), aiColor)) {
+            score = MINIMAX_WIN_SCORE(depth);
+        } else {
+            score = searchMinimax(mb, depth - 1, alpha, INFINITY_SCORE, 0, aiColor).score;
+        }
+        unmakeMove(mb, row, col);
+        if (searchAborted) return best;
+
+        if (score > best.score) {
+            best.score = score;
+            best.row = row;
+            best.col = col;
+            if (score > alpha) alpha = score;
+        }
+    }
+    return best;
+}
+
+static MoveResult searchRootExcluding(unsigned char *mb, int aiColor, int depth,
+                                      const Move rootMoves[], int rootCount,
+                                      const PvLine lines[], int excluded) {
+    if (!traceOn) return searchRootExcludingNode(mb, aiColor, depth, rootMoves, rootCount, lines, excluded);
+
+    int move = traceEnter();
+    MoveResult best = searchRootExcludingNode(mb, aiColor, depth, rootMoves, rootCount, lines, excluded);
+    traceLeave(TRACE_ROOT, move, depth, 1, -INFINITY_SCORE, INFINITY_SCORE, best.score, best.row, best.col);
+    return best;
+}
+
+// 루트 수 뒤의 진행을 치환표의 최선 수로 이어 붙임
+static void extractPv(unsigned char *mb, int aiColor, PvLine *line) {
+    int opponent = (aiColor == BLACK) ? WHITE : BLACK;
+    int isMaximizing = 0;
+
+    line->pv[0] = line->move;
+    line->pvLength = 1;
+    makeMove(mb, line->move.row, line->move.col, aiColor);
+
+    if (!mbCheckWin(mb, MB_INDEX(line->move.row, line->move.col), aiColor)) {
+        while (line->pvLength < MAX_PV_LENGTH && line->pvLength < line->depth) {
+            unsigned long long key = searchHash ^ (isMaximizing ? zobristMax : 0);
+            TTEntry *entry = &transTable[key & (TT_SIZE - 1)];
+            if (entry->key != key || entry->move < 0 || mb[entry->move] != EMPTY) break;
+
+            int color = isMaximizing ? aiColor : opponent;
+            Move next = {MB_ROW(entry->move), MB_COL(entry->move)};
+            makeMove(mb, next.row, next.col, color);
+            line->pv[line->pvLength++] = next;
+            if (mbCheckWin(mb, entry->move, color)) break;
+            isMaximizing = !isMaximizing;
+        }
+    }
+
+    for (int i = line->pvLength - 1; i >= 0; i--) {
+        unmakeMove(mb, line->pv[i].row, line->pv[i].col);
+    }
+}
+
+int findBestMoves(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int k, int budgetMs, PvLine out[]) {
+    if (!initialized) {
+        initAI();
+    }
+    if (k <= 0) return 0;
+
+    if (transTable == NULL) {
+        transTable = (TTEntry*)malloc(TT_SIZE * sizeof(TTEntry));
+        if (transTable == NULL) return 0;
+    }
+    memset(transTable, 0, TT_SIZE * sizeof(TTEntry));
+    searchNodes = 0;
+    evalProbes = evalHits = 0;
+    traceMark(aiColor);
+
+    unsigned char mb[MB_CELLS];
+    mbFromBoard(mb, board);
+    syncForbidMap(mb);
+
+    // 루트 후보 (공격+방어 점수 순, 이후 반복에서는 직전 순위 순)
+    Move rootMoves[MAX_MOVES];
+    int moveCount = getPossibleMovesMb(mb, rootMoves, MAX_MOVES);
+    moveCount = removeForbidden(rootMoves, moveCount, aiColor);
+
+    ScoredMove scored[MAX_MOVES];
+    int opponent = (aiColor == BLACK) ? WHITE : BLACK;
+    for (int i = 0; i < moveCount; i++) {
+        int idx = MB_INDEX(rootMoves[i].row, rootMoves[i].col);
+        scored[i].row = rootMoves[i].row;
+        scored[i].col = rootMoves[i].col;
+        scored[i].score = evaluatePosition(mb, idx, aiColor) + evaluatePosition(mb, idx, opponent);
+    }
+    sortMoves(scored, moveCount);
+
+    int rootCount = (moveCount < ANALYSIS_ROOT_MOVES) ? moveCount : ANALYSIS_ROOT_MOVES;
+    if (k > rootCount) rootCount = (k < moveCount) ? k : moveCount;
+    for (int i = 0; i < rootCount; i++) {
+        rootMoves[i].row = scored[i].row;
+        rootMoves[i].col = scored[i].col;
+    }
+    if (k > rootCount) k = rootCount;
+    if (k == 0) return 0;
+
+    // 분석은 한 수 시계 비율이 아니라 예산 전체를 씀
+    startClock(mb, aiColor, budgetMs);
+    searchClock.softMs = searchClock.hardMs;
+    int firstDepth = clockActive ? 1 : ANALYSIS_DEPTH;
+    int lastDepth = clockActive ? MINIMAX_MAX_DEPTH : ANALYSIS_DEPTH;
+
+    PvLine current[MAX_MOVES];
+    int count = 0;
+    int filled = 0;
+
+    syncPatterns(mb);
+    ttActive = 1;
+    beginSearch(mb);
+    for (int depth = firstDepth; depth <= lastDepth; depth++) {
+        long long iterStart = tmNowMs();
+
+        // k개 루트 탐색이 같은 치환표를 쓰므로 두 번째부터는 대부분 표에서 끝남
+        for (count = 0; count < k; count++) {
+            MoveResult result = searchRootExcluding(mb, aiColor, depth, rootMoves, rootCount,
+                                                    current, count);
+            if (searchAborted || result.row < 0) break;
+            current[count].move.row = result.row;
+            current[count].move.col = result.col;
+            current[count].score = result.score;
+            current[count].depth = depth;
+        }
+
+        // 중단된 반복은 버림 (첫 반복이면 끝난 줄까지만 사용)
+        if (searchAborted && filled > 0) break;
+
+        for (int i = 0; i < count; i++) {
+            extractPv(mb, aiColor, &current[i]);
+        }
+        memcpy(out, current, count * sizeof(PvLine));
+        filled = count;
+        if (searchAborted) break;
+
+        // 다음 반복은 이번 순위대로 먼저 탐색
+        Move reordered[MAX_MOVES];
+        int n = 0;
+        for (int i = 0; i < count; i++) reordered[n++] = current[i].move;
+        for (int i = 0; i < rootCount; i++) {
+            int reported = 0;
+            for (int j = 0; j < count; j++) {
+                if (current[j].move.row == rootMoves[i].row && current[j].move.col == rootMoves[i].col) {
+                    reported = 1;
+                }
+            }
+            if (!reported) reordered[n++] = rootMoves[i];
+        }
+        memcpy(rootMoves, reordered, rootCount * sizeof(Move));
+
+        if (!clockActive) break;
+        if (!tmNextIteration(&searchClock, current[0].move.row * BOARD_SIZE + current[0].move.col,
+                             (int)(tmNowMs() - iterStart))) {
+            break;
+        }
+    }
+    endSearch();
+    ttActive = 0;
+    clockActive = 0;
+    patternMb = NULL;
+
+    return filled;
+}
@@ -3,7 +3,9 @@
 #ifndef MINIMAX_H
 #define MINIMAX_H
 
-#define BOARD_SIZE 15
+#include "mailbox.h"
+
+#define BOARD_SIZE MB_BOARD_SIZE    // 컴파일 시 보드 크기 (mailbox.h의 OMOK_BOARD_SIZE)
 #define EMPTY 0
 #define BLACK 1
 #define WHITE 2
@@ -13,6 +15,28 @@
 #define MEDIUM 1
 #define HARD 2
 
+#define MAX_DEPTH_HARD 12   // 어려움 모드: 반복 심화 한계
+
+// 난이도별 한 수 예산: 노드 수는 정확히 지키고, 시간은 느린 기기를 위한 상한
+// 반복 심화로 예산 안에서 갈 수 있는 깊이까지 탐색한다 (무작위 실수 없음)
+// 엔진(minimax.c)과 클라이언트 내장 AI(GameControl.c)가 같은 표를 쓴다 (클라이언트는 쉬움/보통만)
+typedef struct {
+    long long nodes;        // 노드 상한 (엔진은 정지 탐색 포함)
+    int timeMs;             // 턴 시계가 없을 때의 하드 데드라인
+    int maxDepth;           // 반복 심화 한계
+    int cacheDepth;         // 이 깊이 이상의 분석 캐시 결과는 그대로 사용 (0 = 캐시 안 씀)
+} SearchBudget;
+
+static const SearchBudget difficultyBudget[3] = {
+    {2000,    100,   3,              0},    // 쉬움 (약하게 두도록 캐시의 깊은 결과도 안 씀)
+    {50000,   1000,  6,              4},    // 보통
+    {2000000, 10000, MAX_DEPTH_HARD, 8},    // 어려움
+};
+
+// 어려움 모드 탐색 엔진
+#define ENGINE_ALPHABETA 0  // 고정 폭 Alpha-Beta (minimaxHard)
+#define ENGINE_MCTS 1       // 멀티스레드 MCTS (mcts.c)
+
 // 착수 위치 구조체
 typedef struct {
     int row;
@@ -26,9 +50,29 @@ typedef struct {
     int col;
 } MoveResult;
 
+// 다중 PV 분석 결과 (findBestMoves)
+#define MAX_PV_LENGTH 12
+typedef struct {
+    Move move;                  // 루트 수
+    int score;                  // AI 관점 점수
+    int depth;                  // 완료된 탐색 깊이
+    int pvLength;               // pv[0] == move
+    Move pv[MAX_PV_LENGTH];     // 예상 진행 (양쪽 교대)
+} PvLine;
+
 // 함수 선언
 void initAI(void);      // AI 초기화 (Transposition Table, Zobrist 등)
 void cleanupAI(void);   // AI 정리 (메모리 해제)
+void cleanupSearchThread(void);     // 작업 스레드 종료 전 그 스레드의 탐색 메모리 해제
+
+void setSearchEngine(int engine);   // 어려움 모드 탐색 엔진 선택 (ENGINE_*)
+void setSearchTimeBudget(int ms);   // 한 수당 탐색 시간 예산 (MCTS)
+void setTurnTime(int ms);           // 한 수당 시계 (반복 심화 + 하드 데드라인, 0 = 난이도별 노드/시간 예산만)
+long long getLastSearchNodes(void); // 마지막 findBestMove의 노드(플레이아웃) 수
+void getEvalCacheStats(long long *probes, long long *hits);   // 마지막 탐색의 평가 캐시 조회/적중 수
+void setNeuralEval(int enabled);    // 신경망 평가 사용 (initAI가 가중치 파일을 읽은 경우)
+void setForbiddenRules(int rules);  // 흑 금수 규칙 (forbid.h의 FORBID_* 조합, 0 = 없음)
+void setPortfolioSearch(int mode);  // 어려움 모드 VCF 증명 스레드 병행 (1 켬, 0 끔, -1 코어 2개 이상이면 자동)
 
 int checkWinBoard(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int color);
 int evaluateBoard(int board[BOARD_SIZE][BOARD_SIZE], int aiColor);
@@ -36,4 +80,8 @@ int getPossibleMoves(int board[BOARD_SIZE][BOARD_SIZE], Move moves[], int maxCou
 MoveResult minimax(int board[BOARD_SIZE][BOARD_SIZE], int depth, int alpha, int beta, int isMaximizing, int aiColor);
 Move findBestMove(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int difficulty);
 
+// 상위 k개 수를 점수, PV와 함께 반환 (점수 내림차순, 반환값 = 채운 줄 수)
+// budgetMs > 0이면 그 시간 안에서 반복 심화, 0이면 보통 난이도 고정 깊이
+int findBestMoves(int board[BOARD_SIZE][BOARD_SIZE], int aiColor, int k, int budgetMs, PvLine out[]);
+
 #endif
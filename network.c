@@ -279,6 +279,7 @@ int net_recv_message_nonblock(SOCKET_TYPE sock, NetMessage* msg) {
 void net_create_connect_msg(NetMessage* msg, const char* nickname) {
     memset(msg, 0, sizeof(NetMessage));
     msg->type = MSG_CONNECT;
+    msg->x = NET_PROTOCOL_VERSION;
     strncpy(msg->nickname, nickname, sizeof(msg->nickname) - 1);
 }
 
@@ -305,40 +306,9 @@ void net_create_game_end_msg(NetMessage* msg, int result) {
 
 /* ========== 승리 체크 (서버용) ========== */
 
-int net_check_win(int board[BOARD_NET_SIZE][BOARD_NET_SIZE], int x, int y, int player) {
-    int dx[] = {1, 0, 1, 1};
-    int dy[] = {0, 1, 1, -1};
-    int dir;
-    int count;
-    int nx, ny;
-
-    for (dir = 0; dir < 4; dir++) {
-        count = 1;
-
-        /* 정방향 */
-        nx = x + dx[dir];
-        ny = y + dy[dir];
-        while (nx >= 0 && nx < BOARD_NET_SIZE && ny >= 0 && ny < BOARD_NET_SIZE
-               && board[ny][nx] == player) {
-            count++;
-            nx += dx[dir];
-            ny += dy[dir];
-        }
-
-        /* 역방향 */
-        nx = x - dx[dir];
-        ny = y - dy[dir];
-        while (nx >= 0 && nx < BOARD_NET_SIZE && ny >= 0 && ny < BOARD_NET_SIZE
-               && board[ny][nx] == player) {
-            count++;
-            nx -= dx[dir];
-            ny -= dy[dir];
-        }
-
-        if (count >= 5) {
-            return player;
-        }
+int net_check_win(const unsigned char *board, int size, int x, int y, int player) {
+    if (size == 19) {
+        return mbCheckWin19(board, MB_INDEX_N(19, y, x), player) ? player : 0;
     }
-
-    return 0;
+    return mbCheckWin15(board, MB_INDEX_N(15, y, x), player) ? player : 0;
 }
@@ -11,6 +11,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "mailbox.h"
+#include "forbid.h"
 
 /* 플랫폼별 소켓 헤더 */
 #ifdef _WIN32
@@ -42,9 +44,18 @@
 #define BUFFER_SIZE 4096
 #define MAX_CLIENTS 20
 #define MAX_ROOMS 10
-#define BOARD_NET_SIZE 15
+#define BOARD_NET_SIZE 15         /* 기본 방 크기 (클라이언트가 크기를 안 보내면) */
+#define BOARD_NET_MAX_SIZE MB_MAX_BOARD_SIZE   /* 방 크기는 15 또는 19 */
 #define ROOM_NAME_LEN 32
 
+/*
+ * 프로토콜 버전 (MSG_CONNECT의 x로 보내고 MSG_CONNECT_ACK의 x로 받음, 0 = 버전 1)
+ * 메시지는 NetMessage 구조체를 그대로 보내고 받는 쪽은 길이가 다르면 버리므로
+ * 구조체 배치는 바꾸지 않는다. 새 정보는 이전 버전이 0으로 채워 보내거나 읽지 않는 필드에 싣는다.
+ *   2: 방 크기 (생성·입장 y, 방 목록 응답 result의 19x19 비트, 게임 시작 x)
+ */
+#define NET_PROTOCOL_VERSION 2
+
 /* 메시지 타입 */
 typedef enum {
     MSG_CONNECT = 1,        /* 서버 접속 요청 */
@@ -95,10 +106,10 @@ typedef struct {
 /* 네트워크 메시지 구조체 */
 typedef struct {
     int type;               /* MessageType */
-    int x;                  /* 착수 x좌표 / roomId */
-    int y;                  /* 착수 y좌표 / roomCount */
+    int x;                  /* 착수 x좌표 / roomId / 프로토콜 버전(접속) / 방 크기(게임 시작) */
+    int y;                  /* 착수 y좌표 / roomCount / 방 크기(생성·입장, 0이면 15) */
     int player;             /* 플레이어 색상 (1=흑, 2=백) */
-    int result;             /* 게임 결과 */
+    int result;             /* 게임 결과 / 방 목록: rooms[i]가 19x19면 비트 i */
     char nickname[50];      /* 닉네임 / 방 이름 */
     char message[256];      /* 추가 메시지 */
     RoomInfo rooms[MAX_ROOMS]; /* 방 목록 (MSG_ROOM_LIST_RESP용) */
@@ -123,7 +134,9 @@ typedef struct {
     int hostIndex;          /* 방장 클라이언트 인덱스 */
     int guestIndex;         /* 참가자 클라이언트 인덱스 */
     int inGame;
-    int board[BOARD_NET_SIZE][BOARD_NET_SIZE];
+    int boardSize;          /* 15 또는 19 */
+    unsigned char board[MB_CELLS_N(BOARD_NET_MAX_SIZE)];  /* 메일박스 보드 (MB_INDEX_N(boardSize, y, x)) */
+    ForbidMap forbid;       /* 흑 금수 맵 (렌주 규칙 + 15x15 방에서만) */
     int currentTurn;        /* 1=흑, 2=백 */
     int moveCount;
 } GameRoom;
@@ -157,7 +170,7 @@ void net_create_move_msg(NetMessage* msg, int x, int y, int player);
 void net_create_game_start_msg(NetMessage* msg, int yourColor, const char* opponentNick);
 void net_create_game_end_msg(NetMessage* msg, int result);
 
-/* 승리 체크 (서버용) */
-int net_check_win(int board[BOARD_NET_SIZE][BOARD_NET_SIZE], int x, int y, int player);
+/* 승리 체크 (서버용, size: 방 크기 15/19) */
+int net_check_win(const unsigned char *board, int size, int x, int y, int player);
 
 #endif /* NETWORK_H */
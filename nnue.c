@@ -0,0 +1,226 @@
+// 오목 AI - NNUE 방식 신경망 평가 함수 (CPU 전용 정수 추론)
+// 핵심: 1층 누산기 증분 갱신, 이후 층은 int16 SIMD 내적
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "minimax.h"
+#include "nnue.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#define NNUE_VERSION 1
+#define NNUE_CELLS (BOARD_SIZE * BOARD_SIZE)
+
+// 가중치 (2층 이후 int8 가중치는 SIMD 내적을 위해 int16으로 펼쳐 보관)
+static short ftWeights[NNUE_FEATURES][NNUE_HIDDEN];
+static short ftBias[NNUE_HIDDEN];
+static short l1Weights[NNUE_HIDDEN2][2 * NNUE_HIDDEN];
+static int l1Bias[NNUE_HIDDEN2];
+static int outWeights[NNUE_HIDDEN2];
+static int outBias = 0;
+static int outputScale = 256;
+static int loaded = 0;
+
+// ========== 파일 읽기 (리틀 엔디언) ==========
+
+static int readInt32(FILE *fp, int *value) {
+    unsigned char b[4];
+    if (fread(b, 1, 4, fp) != 4) return 0;
+    *value = (int)((unsigned int)b[0] | ((unsigned int)b[1] << 8) |
+                   ((unsigned int)b[2] << 16) | ((unsigned int)b[3] << 24));
+    return 1;
+}
+
+static int readInt16Array(FILE *fp, short *dst, int count) {
+    unsigned char b[2];
+    for (int i = 0; i < count; i++) {
+        if (fread(b, 1, 2, fp) != 2) return 0;
+        dst[i] = (short)((unsigned short)b[0] | ((unsigned short)b[1] << 8));
+    }
+    return 1;
+}
+
+static int readInt8Array(FILE *fp, short *dst, int count) {
+    for (int i = 0; i < count; i++) {
+        int c = fgetc(fp);
+        if (c == EOF) return 0;
+        dst[i] = (short)(signed char)c;
+    }
+    return 1;
+}
+
+// 가중치 파일 로드 (형식은 nnue.h 참고)
+int nnueLoad(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    char magic[4];
+    int version, boardSize, hidden, hidden2, scale;
+    int ok = 0;
+
+    loaded = 0;
+    if (fp == NULL) return 0;
+
+    if (fread(magic, 1, 4, fp) == 4 && memcmp(magic, "ONNU", 4) == 0 &&
+        readInt32(fp, &version) && version == NNUE_VERSION &&
+        readInt32(fp, &boardSize) && boardSize == BOARD_SIZE &&
+        readInt32(fp, &hidden) && hidden == NNUE_HIDDEN &&
+        readInt32(fp, &hidden2) && hidden2 == NNUE_HIDDEN2 &&
+        readInt32(fp, &scale)) {
+        short tmp[NNUE_HIDDEN2];
+        ok = readInt16Array(fp, &ftWeights[0][0], NNUE_FEATURES * NNUE_HIDDEN) &&
+             readInt16Array(fp, ftBias, NNUE_HIDDEN) &&
+             readInt8Array(fp, &l1Weights[0][0], NNUE_HIDDEN2 * 2 * NNUE_HIDDEN);
+        for (int i = 0; ok && i < NNUE_HIDDEN2; i++) {
+            ok = readInt32(fp, &l1Bias[i]);
+        }
+        ok = ok && readInt8Array(fp, tmp, NNUE_HIDDEN2) && readInt32(fp, &outBias);
+        for (int i = 0; ok && i < NNUE_HIDDEN2; i++) {
+            outWeights[i] = tmp[i];
+        }
+        outputScale = scale;
+    }
+
+    fclose(fp);
+    loaded = ok;
+    return ok;
+}
+
+void nnueUnload(void) {
+    loaded = 0;
+}
+
+int nnueIsLoaded(void) {
+    return loaded;
+}
+
+// ========== SIMD 커널 ==========
+
+static void addColumn(short *acc, const short *w) {
+#if defined(__SSE2__)
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(acc + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(w + i));
+        _mm_storeu_si128((__m128i*)(acc + i), _mm_add_epi16(a, b));
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; i++) acc[i] += w[i];
+#endif
+}
+
+static void subColumn(short *acc, const short *w) {
+#if defined(__SSE2__)
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(acc + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(w + i));
+        _mm_storeu_si128((__m128i*)(acc + i), _mm_sub_epi16(a, b));
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; i++) acc[i] -= w[i];
+#endif
+}
+
+// clipped ReLU: [0, NNUE_CLIP]
+static void clipActivations(short *dst, const short *src) {
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i clip = _mm_set1_epi16(NNUE_CLIP);
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_min_epi16(_mm_max_epi16(v, zero), clip));
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        short v = src[i];
+        dst[i] = (v < 0) ? 0 : (v > NNUE_CLIP ? NNUE_CLIP : v);
+    }
+#endif
+}
+
+// int16 내적 (n은 16의 배수)
+static int dotProduct(const short *a, const short *b, int n) {
+#if defined(__AVX2__)
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(x, y));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+#elif defined(__SSE2__)
+    __m128i s = _mm_setzero_si128();
+    for (int i = 0; i < n; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        s = _mm_add_epi32(s, _mm_madd_epi16(x, y));
+    }
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+#else
+    int sum = 0;
+    for (int i = 0; i < n; i++) sum += a[i] * b[i];
+    return sum;
+#endif
+}
+
+// ========== 누산기 ==========
+
+// 관점 perspective(0=흑, 1=백)에서 돌의 특징 인덱스
+static int featureIndex(int perspective, int row, int col, int color) {
+    int own = ((color == BLACK) == (perspective == 0));
+    return (own ? 0 : NNUE_CELLS) + row * BOARD_SIZE + col;
+}
+
+// 보드 전체로 누산기 재계산
+void nnueRefresh(NnueAccumulator *acc, const unsigned char *mb) {
+    for (int p = 0; p < 2; p++) {
+        memcpy(acc->acc[p], ftBias, sizeof(ftBias));
+    }
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int color = mb[MB_INDEX(row, col)];
+            if (color != EMPTY) {
+                nnueAddStone(acc, row, col, color);
+            }
+        }
+    }
+}
+
+void nnueAddStone(NnueAccumulator *acc, int row, int col, int color) {
+    addColumn(acc->acc[0], ftWeights[featureIndex(0, row, col, color)]);
+    addColumn(acc->acc[1], ftWeights[featureIndex(1, row, col, color)]);
+}
+
+void nnueRemoveStone(NnueAccumulator *acc, int row, int col, int color) {
+    subColumn(acc->acc[0], ftWeights[featureIndex(0, row, col, color)]);
+    subColumn(acc->acc[1], ftWeights[featureIndex(1, row, col, color)]);
+}
+
+// 추론: aiColor 관점 누산기를 앞쪽에 두고 2층 → 출력
+int nnueEvaluate(const NnueAccumulator *acc, int aiColor) {
+    short input[2 * NNUE_HIDDEN];
+    short hidden[NNUE_HIDDEN2];
+    int p = (aiColor == BLACK) ? 0 : 1;
+
+    clipActivations(input, acc->acc[p]);
+    clipActivations(input + NNUE_HIDDEN, acc->acc[1 - p]);
+
+    for (int j = 0; j < NNUE_HIDDEN2; j++) {
+        int v = (l1Bias[j] + dotProduct(l1Weights[j], input, 2 * NNUE_HIDDEN)) >> NNUE_L1_SHIFT;
+        hidden[j] = (short)((v < 0) ? 0 : (v > NNUE_CLIP ? NNUE_CLIP : v));
+    }
+
+    long long out = outBias;
+    for (int j = 0; j < NNUE_HIDDEN2; j++) {
+        out += (long long)outWeights[j] * hidden[j];
+    }
+
+    return (int)(out * outputScale / 256);
+}
@@ -0,0 +1,56 @@
+// NNUE 방식 신경망 평가 함수 헤더 (선택 사항, CPU 전용)
+//
+// 구조: (내 돌/상대 돌 x 칸) 특징 → int16 누산기 2개(흑/백 관점)
+//       → clipped ReLU → int16 x int8 완전연결층 → 출력 1개
+// 1층 누산기는 착수/무르기 때 돌 하나의 가중치 열만 더하고 빼서 갱신한다.
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "minimax.h"
+#include "mailbox.h"
+
+#define NNUE_FEATURES (2 * BOARD_SIZE * BOARD_SIZE)  // [내 돌 | 상대 돌] x 칸
+#define NNUE_HIDDEN 64          // 관점별 누산기 크기
+#define NNUE_HIDDEN2 32         // 2층 크기
+#define NNUE_CLIP 127           // clipped ReLU 상한
+#define NNUE_L1_SHIFT 6         // 2층 출력 축소 비트 수
+#if BOARD_SIZE == 15
+#define NNUE_DEFAULT_FILE "omok_nnue.bin"
+#else
+#define NNUE_DEFAULT_FILE "omok_nnue19.bin"
+#endif
+
+/*
+ * 가중치 파일 형식 (리틀 엔디언, 헤더 24바이트 + 본문)
+ *   char   magic[4]                         "ONNU"
+ *   int32  version                          1
+ *   int32  boardSize                        BOARD_SIZE (15 또는 19)
+ *   int32  hidden                           NNUE_HIDDEN
+ *   int32  hidden2                          NNUE_HIDDEN2
+ *   int32  outputScale                      평가값 = 출력 * outputScale / 256
+ *   int16  ftWeights[NNUE_FEATURES][NNUE_HIDDEN]
+ *   int16  ftBias[NNUE_HIDDEN]
+ *   int8   l1Weights[NNUE_HIDDEN2][2 * NNUE_HIDDEN]   (앞쪽 절반: 평가 관점)
+ *   int32  l1Bias[NNUE_HIDDEN2]
+ *   int8   outWeights[NNUE_HIDDEN2]
+ *   int32  outBias
+ */
+
+// 1층 누산기 (관점 0 = 흑, 1 = 백)
+typedef struct {
+    short acc[2][NNUE_HIDDEN];
+} NnueAccumulator;
+
+int nnueLoad(const char *path);     // 성공 시 1
+void nnueUnload(void);
+int nnueIsLoaded(void);
+
+void nnueRefresh(NnueAccumulator *acc, const unsigned char *mb);   // 메일박스 보드
+void nnueAddStone(NnueAccumulator *acc, int row, int col, int color);
+void nnueRemoveStone(NnueAccumulator *acc, int row, int col, int color);
+
+// aiColor 입장 평가값 (evaluateBoard와 같은 부호/단위)
+int nnueEvaluate(const NnueAccumulator *acc, int aiColor);
+
+#endif
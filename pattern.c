@@ -0,0 +1,82 @@
+// 패턴 보드 (엔진 탐색용)
+
+#include <string.h>
+#include "pattern.h"
+
+// 빈칸 idx의 dir 방향 코드 (두 색)
+// 한쪽 이웃 돌의 색은 하나뿐이므로 양쪽으로 한 번씩만 걷고 두 색 코드를 함께 만든다
+static void setLine(PatternBoard *pb, const unsigned char *mb, int idx, int dir) {
+    if (mb[idx] != MB_EMPTY) {
+        pb->code[idx][0][dir] = 0;
+        pb->code[idx][1][dir] = 0;
+        return;
+    }
+
+    int d = MB_DIR[dir];
+    int frontColor = mb[idx + d];
+    int backColor = mb[idx - d];
+    int frontRun = 0;
+    int backRun = 0;
+    int p;
+
+    // 이웃이 돌이면 그 색 연속 돌 끝까지 (끝 칸이 빈칸이면 열림)
+    int frontEnd = frontColor;
+    if (frontColor == 1 || frontColor == 2) {
+        for (p = idx + d; mb[p] == frontColor; p += d) frontRun++;
+        frontEnd = mb[p];
+    }
+    int backEnd = backColor;
+    if (backColor == 1 || backColor == 2) {
+        for (p = idx - d; mb[p] == backColor; p -= d) backRun++;
+        backEnd = mb[p];
+    }
+
+    for (int color = 1; color <= 2; color++) {
+        int count = 1;
+        int openEnds = 0;
+        if (frontColor == color) {
+            count += frontRun;
+            openEnds += (frontEnd == MB_EMPTY);
+        } else {
+            openEnds += (frontColor == MB_EMPTY);
+        }
+        if (backColor == color) {
+            count += backRun;
+            openEnds += (backEnd == MB_EMPTY);
+        } else {
+            openEnds += (backColor == MB_EMPTY);
+        }
+        pb->code[idx][color - 1][dir] = (unsigned char)PAT_CODE(count, openEnds);
+    }
+}
+
+void patRebuild(PatternBoard *pb, const unsigned char *mb) {
+    memset(pb->code, 0, sizeof(pb->code));
+    for (int row = 0; row < MB_BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < MB_BOARD_SIZE; col++, idx++) {
+            for (int dir = 0; dir < 4; dir++) {
+                setLine(pb, mb, idx, dir);
+            }
+        }
+    }
+}
+
+// 착수/무르기 모두 같은 방식: 변경 칸의 4방향 + 각 라인 위 ±4칸의 그 방향 (벽에서 멈춤)
+void patUpdate(PatternBoard *pb, const unsigned char *mb, int idx) {
+    PROF_BEGIN(PROF_PATTERN_UPDATE);
+    for (int dir = 0; dir < 4; dir++) {
+        int d = MB_DIR[dir];
+
+        setLine(pb, mb, idx, dir);
+        int p = idx + d;
+        for (int k = 0; k < PAT_RANGE && mb[p] != MB_WALL; k++, p += d) {
+            setLine(pb, mb, p, dir);
+        }
+        p = idx - d;
+        for (int k = 0; k < PAT_RANGE && mb[p] != MB_WALL; k++, p -= d) {
+            setLine(pb, mb, p, dir);
+        }
+    }
+    PROF_END(PROF_PATTERN_UPDATE);
+}
@@ -0,0 +1,30 @@
+// 패턴 보드 헤더 (칸/방향/색별 라인 패턴 캐시)
+//
+// 빈칸마다, 4방향과 두 색 각각에 대해 "그 칸에 color를 둔다면" 생기는
+// mbAnalyzeLine 결과(연속 돌 수, 열린 끝 수)를 코드 하나로 저장한다.
+// 돌 하나가 바뀌면 그 칸과, 그 칸을 지나는 4개 라인 위 ±4칸의 해당 방향만 다시 계산한다.
+// 5칸 이상 떨어진 돌은 사이가 모두 같은 색이어야 영향을 주는데, 그러면 이미 5목 이상이라
+// 점수가 바뀌지 않는다.
+
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include "mailbox.h"
+
+#define PAT_RANGE 4
+#define PAT_FIVE 15
+#define PAT_CODES 16
+
+// 코드 = 연속 수 * 3 + 열린 끝 수, 5목 이상은 열린 끝과 무관하게 PAT_FIVE (돌이 있는 칸은 0)
+#define PAT_CODE(count, openEnds) (((count) >= 5) ? PAT_FIVE : (count) * 3 + (openEnds))
+#define PAT_COUNT(code) ((code) / 3)
+#define PAT_OPEN(code) ((code) % 3)
+
+typedef struct {
+    unsigned char code[MB_CELLS][2][4];     // [칸][색 - 1][방향]
+} PatternBoard;
+
+void patRebuild(PatternBoard *pb, const unsigned char *mb);            // 보드 전체 계산
+void patUpdate(PatternBoard *pb, const unsigned char *mb, int idx);    // idx 칸 변경 후
+
+#endif
@@ -0,0 +1,227 @@
+// 학습용 국면 레코드 (고정 크기 인코딩, 정규 해시, 샤드 쓰기/스트리밍 읽기)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "posrec.h"
+
+#define CELLS (BOARD_SIZE * BOARD_SIZE)
+
+// ========== 레코드 (리틀 엔디언) ==========
+// u8 보드[POSREC_BOARD_BYTES], u8 둘 차례 | 결과 << 2, u16 최선 수, i32 점수, 0 채움
+
+static void putU16(unsigned char *p, unsigned int v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static unsigned int getU16(const unsigned char *p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+static void putU32(unsigned char *p, unsigned int v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned int getU32(const unsigned char *p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+           ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+void posrecEncode(unsigned char *out, const PosRecord *record) {
+    memset(out, 0, POSREC_SIZE);
+    for (int i = 0; i < CELLS; i++) {
+        int cell = record->board[i / BOARD_SIZE][i % BOARD_SIZE] & 3;
+        out[i >> 2] |= (unsigned char)(cell << ((i & 3) * 2));
+    }
+
+    unsigned char *p = out + POSREC_BOARD_BYTES;
+    p[0] = (unsigned char)((record->toMove & 3) | ((record->result & 3) << 2));
+    putU16(p + 1, record->best.row >= 0 ? (unsigned int)(record->best.row * BOARD_SIZE + record->best.col)
+                                        : POSREC_NO_MOVE);
+    putU32(p + 3, (unsigned int)record->score);
+}
+
+int posrecDecode(const unsigned char *in, PosRecord *record) {
+    record->ply = 0;
+    for (int i = 0; i < CELLS; i++) {
+        int cell = (in[i >> 2] >> ((i & 3) * 2)) & 3;
+        if (cell == 3) return 0;
+        record->board[i / BOARD_SIZE][i % BOARD_SIZE] = cell;
+        if (cell != EMPTY) record->ply++;
+    }
+
+    const unsigned char *p = in + POSREC_BOARD_BYTES;
+    unsigned int move = getU16(p + 1);
+    record->toMove = p[0] & 3;
+    record->result = (p[0] >> 2) & 3;
+    record->score = (int)getU32(p + 3);
+    if (record->toMove != BLACK && record->toMove != WHITE) return 0;
+    if (record->result == 3 || (p[0] >> 4) != 0) return 0;
+
+    if (move == POSREC_NO_MOVE) {
+        record->best.row = record->best.col = -1;
+    } else if (move < CELLS) {
+        record->best.row = (int)move / BOARD_SIZE;
+        record->best.col = (int)move % BOARD_SIZE;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+// ========== 정규 해시 ==========
+// 분석 캐시(anacache.c)와 같은 방식: 고정 시드 Zobrist, 8가지 대칭 중 최솟값
+
+static unsigned long long zobrist[2][CELLS];
+static unsigned long long zobristSide[3];
+static int zobristReady = 0;
+
+static unsigned long long splitmix64(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void initZobrist(void) {
+    unsigned long long seed = 0x6F6D6F6B504F5352ULL;
+    for (int c = 0; c < 2; c++) {
+        for (int i = 0; i < CELLS; i++) zobrist[c][i] = splitmix64(&seed);
+    }
+    for (int i = 0; i < 3; i++) zobristSide[i] = splitmix64(&seed);
+    zobristReady = 1;
+}
+
+// sym 비트: 4 = 전치, 1 = 상하 반전, 2 = 좌우 반전 (이 순서로 적용)
+static int symCell(int sym, int row, int col) {
+    const int last = BOARD_SIZE - 1;
+    if (sym & 4) { int t = row; row = col; col = t; }
+    if (sym & 1) row = last - row;
+    if (sym & 2) col = last - col;
+    return row * BOARD_SIZE + col;
+}
+
+unsigned long long posrecKey(const PosRecord *record) {
+    unsigned long long h[8] = {0};
+
+    if (!zobristReady) initZobrist();
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            int cell = record->board[row][col];
+            if (cell != BLACK && cell != WHITE) continue;
+            const unsigned long long *z = zobrist[cell - 1];
+            for (int s = 0; s < 8; s++) {
+                h[s] ^= z[symCell(s, row, col)];
+            }
+        }
+    }
+
+    unsigned long long best = h[0];
+    for (int s = 1; s < 8; s++) {
+        if (h[s] < best) best = h[s];
+    }
+    best ^= zobristSide[record->toMove % 3];
+    return best ? best : 1;
+}
+
+// ========== 샤드 쓰기 ==========
+
+static void encodeHeader(unsigned char *p) {
+    memset(p, 0, POSREC_HEADER_SIZE);
+    memcpy(p, POSREC_MAGIC, 4);
+    putU16(p + 4, POSREC_VERSION);
+    putU16(p + 6, POSREC_SIZE);
+    putU16(p + 8, BOARD_SIZE);
+}
+
+static int openShard(PosWriter *w) {
+    char path[sizeof(w->prefix) + 16];
+    unsigned char header[POSREC_HEADER_SIZE];
+
+    snprintf(path, sizeof(path), "%s_%04d.bin", w->prefix, w->shard);
+    w->fp = fopen(path, "wb");
+    if (w->fp == NULL) return 0;
+
+    encodeHeader(header);
+    w->inShard = 0;
+    return fwrite(header, 1, POSREC_HEADER_SIZE, w->fp) == POSREC_HEADER_SIZE;
+}
+
+int posWriterOpen(PosWriter *w, const char *prefix, long long perShard) {
+    memset(w, 0, sizeof(*w));
+    strncpy(w->prefix, prefix, sizeof(w->prefix) - 1);
+    w->perShard = (perShard > 0) ? perShard : 1;
+    return openShard(w);
+}
+
+int posWriterPut(PosWriter *w, const PosRecord *record) {
+    unsigned char buf[POSREC_SIZE];
+
+    if (w->fp == NULL) return 0;
+    if (w->inShard >= w->perShard) {
+        int ok = fclose(w->fp) == 0;
+        w->fp = NULL;
+        w->shard++;
+        if (!ok || !openShard(w)) return 0;
+    }
+
+    posrecEncode(buf, record);
+    if (fwrite(buf, 1, POSREC_SIZE, w->fp) != POSREC_SIZE) return 0;
+    w->inShard++;
+    w->written++;
+    return 1;
+}
+
+void posWriterClose(PosWriter *w) {
+    if (w->fp != NULL) fclose(w->fp);
+    w->fp = NULL;
+}
+
+// ========== 스트리밍 읽기 ==========
+
+int posReaderOpen(PosReader *r, const char *path) {
+    unsigned char header[POSREC_HEADER_SIZE];
+    unsigned char expected[POSREC_HEADER_SIZE];
+
+    r->count = r->next = 0;
+    r->read = 0;
+    r->corrupt = 0;
+
+    r->fp = fopen(path, "rb");
+    if (r->fp == NULL) return 0;
+
+    // 버전, 레코드 크기, 보드 크기가 모두 같아야 함 (19x19 샤드는 19x19 빌드로만 읽음)
+    encodeHeader(expected);
+    if (fread(header, 1, POSREC_HEADER_SIZE, r->fp) != POSREC_HEADER_SIZE ||
+        memcmp(header, expected, POSREC_HEADER_SIZE) != 0) {
+        fclose(r->fp);
+        r->fp = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+int posReaderNext(PosReader *r, PosRecord *record) {
+    while (r->fp != NULL) {
+        if (r->next >= r->count) {
+            r->count = (int)fread(r->buffer, POSREC_SIZE, POSREC_READ_BATCH, r->fp);
+            r->next = 0;
+            if (r->count == 0) return 0;
+        }
+        if (posrecDecode(r->buffer + (size_t)r->next++ * POSREC_SIZE, record)) {
+            r->read++;
+            return 1;
+        }
+        r->corrupt = 1;
+    }
+    return 0;
+}
+
+void posReaderClose(PosReader *r) {
+    if (r->fp != NULL) fclose(r->fp);
+    r->fp = NULL;
+}
@@ -0,0 +1,71 @@
+// 학습용 국면 레코드 헤더 (자가 대국 데이터 생성 → 평가 가중치/신경망 학습)
+//
+// 국면 하나를 고정 크기 이진 레코드로 담는다. 보드는 칸당 2비트(0 빈칸, 1 흑, 2 백)로
+// 행 우선 순서대로 채우고, 그 뒤에 둘 차례와 대국 결과(1바이트), 최선 수, 탐색 점수가 온다.
+// 15x15는 57 + 1 + 2 + 4 = 64바이트, 19x19는 98바이트를 8의 배수로 맞춘 104바이트다.
+// 수 번호(ply)는 돌 수와 같으므로 따로 저장하지 않는다.
+//
+// 파일(샤드): 16바이트 헤더 다음에 레코드 배열 (리틀 엔디언, 기기와 무관)
+// 헤더: "OMPR", u16 버전, u16 레코드 크기, u16 보드 크기, 6바이트 예약(0)
+
+#ifndef POSREC_H
+#define POSREC_H
+
+#include <stdio.h>
+#include "minimax.h"
+
+#define POSREC_MAGIC "OMPR"
+#define POSREC_VERSION 1
+#define POSREC_HEADER_SIZE 16
+#define POSREC_BOARD_BYTES ((BOARD_SIZE * BOARD_SIZE * 2 + 7) / 8)     // 15: 57, 19: 91
+#define POSREC_SIZE ((POSREC_BOARD_BYTES + 7 + 7) / 8 * 8)              // 15: 64, 19: 104
+#define POSREC_NO_MOVE 0xFFFF
+
+typedef struct {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int toMove;                 // BLACK/WHITE
+    int score;                  // 탐색 점수 (둘 차례 관점)
+    Move best;                  // 탐색이 고른 수 (row < 0이면 없음)
+    int result;                 // 대국 승자 색 (EMPTY = 무승부)
+    int ply;                    // 돌 수 (읽을 때 계산)
+} PosRecord;
+
+// 고정 크기 레코드 인코딩/디코딩 (out/in은 POSREC_SIZE바이트). 디코딩 실패 시 0
+void posrecEncode(unsigned char *out, const PosRecord *record);
+int posrecDecode(const unsigned char *in, PosRecord *record);
+
+// 대칭 8가지 중 최소 해시 (회전/반전된 같은 국면과 둘 차례가 같으면 같은 키, 0이 아님)
+// 첫 호출이 키 표를 만들므로 여러 스레드에서 쓸 때는 처음 한 번을 잠금 안에서 부를 것
+unsigned long long posrecKey(const PosRecord *record);
+
+// 샤드 쓰기: prefix_0000.bin, prefix_0001.bin ... (샤드당 perShard개, 넘치면 다음 파일)
+typedef struct {
+    FILE *fp;
+    char prefix[240];
+    int shard;                  // 지금 쓰는 샤드 번호
+    long long perShard;
+    long long inShard;
+    long long written;          // 전체 레코드 수
+} PosWriter;
+
+int posWriterOpen(PosWriter *w, const char *prefix, long long perShard);   // 성공 시 1
+int posWriterPut(PosWriter *w, const PosRecord *record);                    // 성공 시 1
+void posWriterClose(PosWriter *w);
+
+// 샤드 하나를 앞에서부터 스트리밍으로 읽음 (레코드를 묶음으로 읽어 둠)
+#define POSREC_READ_BATCH 1024
+
+typedef struct {
+    FILE *fp;
+    unsigned char buffer[POSREC_READ_BATCH * POSREC_SIZE];
+    int count;                  // 버퍼에 든 레코드 수
+    int next;
+    long long read;             // 지금까지 넘겨준 레코드 수
+    int corrupt;                // 디코딩에 실패한 레코드가 있었으면 1
+} PosReader;
+
+int posReaderOpen(PosReader *r, const char *path);     // 헤더가 맞으면 1
+int posReaderNext(PosReader *r, PosRecord *record);    // 1 = 읽음, 0 = 끝 (잘못된 레코드는 건너뜀)
+void posReaderClose(PosReader *r);
+
+#endif
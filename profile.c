@@ -0,0 +1,118 @@
+// 핫패스 프로파일링 카운터 (OMOK_PROFILE 빌드 전용)
+
+#include "profile.h"
+
+#ifdef OMOK_PROFILE
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+static const char *PROF_NAMES[PROF_COUNT] = {
+    "mbAnalyzeLine",
+    "evaluatePosition",
+    "evaluateBoardMb",
+    "collectNearbyMoves",
+    "sortMoves (qsort)",
+    "patUpdate",
+    "leafScore (정지 탐색)"
+};
+
+// 스레드별 카운터 블록: 힙에 두고 전역 목록에 연결 (스레드가 끝나도 합계에 남음)
+typedef struct ProfBlock {
+    ProfCounter counters[PROF_COUNT];
+    struct ProfBlock *next;
+} ProfBlock;
+
+static ProfBlock *blocks = NULL;
+static pthread_mutex_t blocksLock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local ProfBlock *threadBlock = NULL;
+static int dumpRegistered = 0;
+
+#if !(defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+unsigned long long profTicks(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (unsigned long long)(now.QuadPart * 1000000000.0 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+#endif
+
+static void dumpAtExit(void) {
+    profDump(stderr);
+}
+
+ProfCounter *profThreadCounters(void) {
+    if (threadBlock == NULL) {
+        ProfBlock *block = (ProfBlock*)calloc(1, sizeof(ProfBlock));
+        if (block == NULL) abort();
+
+        pthread_mutex_lock(&blocksLock);
+        block->next = blocks;
+        blocks = block;
+        if (!dumpRegistered) {
+            atexit(dumpAtExit);
+            dumpRegistered = 1;
+        }
+        pthread_mutex_unlock(&blocksLock);
+        threadBlock = block;
+    }
+    return threadBlock->counters;
+}
+
+static int compareTotals(const void *a, const void *b) {
+    const ProfCounter *x = (const ProfCounter*)a;
+    const ProfCounter *y = (const ProfCounter*)b;
+    return (y->ticks > x->ticks) - (y->ticks < x->ticks);
+}
+
+void profDump(FILE *fp) {
+    // 정렬한 뒤에도 이름을 찾도록 id를 함께 둠
+    struct { ProfCounter total; int id; } rows[PROF_COUNT];
+    int threads = 0;
+
+    memset(rows, 0, sizeof(rows));
+    pthread_mutex_lock(&blocksLock);
+    for (ProfBlock *block = blocks; block; block = block->next) {
+        for (int i = 0; i < PROF_COUNT; i++) {
+            rows[i].total.calls += block->counters[i].calls;
+            rows[i].total.ticks += block->counters[i].ticks;
+        }
+        threads++;
+    }
+    pthread_mutex_unlock(&blocksLock);
+    for (int i = 0; i < PROF_COUNT; i++) rows[i].id = i;
+    qsort(rows, PROF_COUNT, sizeof(rows[0]), compareTotals);
+
+    fprintf(fp, "\n== 프로파일 (스레드 %d개, 단위 %s, 하위 호출 포함) ==\n", threads, PROF_UNIT);
+    fprintf(fp, "%-24s %14s %18s %12s\n", "함수", "호출 수", "총 " PROF_UNIT, "호출당");
+    for (int i = 0; i < PROF_COUNT; i++) {
+        if (rows[i].total.calls == 0) continue;
+        fprintf(fp, "%-24s %14llu %18llu %12.1f\n", PROF_NAMES[rows[i].id],
+                rows[i].total.calls, rows[i].total.ticks,
+                (double)rows[i].total.ticks / rows[i].total.calls);
+    }
+    fflush(fp);
+}
+
+void profReset(void) {
+    pthread_mutex_lock(&blocksLock);
+    for (ProfBlock *block = blocks; block; block = block->next) {
+        memset(block->counters, 0, sizeof(block->counters));
+    }
+    pthread_mutex_unlock(&blocksLock);
+}
+
+#endif
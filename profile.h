@@ -0,0 +1,64 @@
+// 핫패스 프로파일링 카운터 헤더
+//
+// -DOMOK_PROFILE 빌드(make profile-build)에서만 동작하고, 기본 빌드에서는 매크로가
+// 비어 있어 비용이 없다. 스레드마다 (호출 수, 누적 틱)을 따로 쌓고, 종료 시
+// 또는 profDump 호출 시 모든 스레드를 합쳐 총 시간 순으로 출력한다.
+// 틱 단위는 x86에서 rdtsc 사이클, 그 외에는 ns. 시간은 하위 호출을 포함한다.
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+
+typedef enum {
+    PROF_ANALYZE_LINE,      // mbAnalyzeLine
+    PROF_EVAL_POSITION,     // evaluatePosition
+    PROF_EVAL_BOARD,        // evaluateBoardMb
+    PROF_GEN_MOVES,         // collectNearbyMoves (getPossibleMoves*)
+    PROF_SORT_MOVES,        // 후보 정렬 (qsort)
+    PROF_PATTERN_UPDATE,    // patUpdate
+    PROF_LEAF,              // 잎 노드 정지 탐색 전체
+    PROF_COUNT
+} ProfId;
+
+#ifdef OMOK_PROFILE
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define PROF_UNIT "cycles"
+    static inline unsigned long long profTicks(void) { return __rdtsc(); }
+#else
+    #define PROF_UNIT "ns"
+    unsigned long long profTicks(void);
+#endif
+
+typedef struct {
+    unsigned long long calls;
+    unsigned long long ticks;
+} ProfCounter;
+
+ProfCounter *profThreadCounters(void);  // 호출한 스레드의 카운터 (처음이면 등록)
+void profDump(FILE *fp);                // 모든 스레드 합계를 표로 출력
+void profReset(void);
+
+#define PROF_BEGIN(id) unsigned long long profStart_##id = profTicks()
+#define PROF_END(id) do { \
+        ProfCounter *profCounter_ = &profThreadCounters()[id]; \
+        profCounter_->calls++; \
+        profCounter_->ticks += profTicks() - profStart_##id; \
+    } while (0)
+
+#else
+
+#define PROF_BEGIN(id) ((void)0)
+#define PROF_END(id) ((void)0)
+#define profDump(fp) ((void)0)
+#define profReset() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+// 엔진 자가 대국 도구: 어려움 모드 MCTS vs Alpha-Beta
+// 두 백엔드의 승률과 처리량(노드/초, 플레이아웃/초)을 비교한다.
+//
+// 사용법: ./omok_selfplay [대국 수] [한 수당 시계(ms)] [스레드 수]
+// 두 엔진 모두 같은 턴 시계로 시간 관리(timeman.c)를 받는다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "minimax.h"
+#include "mcts.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+// 엔진별 누적 통계
+typedef struct {
+    const char *name;
+    int wins;
+    int moves;
+    long long totalMs;
+    long long totalNodes;
+    long long evalProbes;       // 평가 캐시 조회/적중 (Alpha-Beta만)
+    long long evalHits;
+} EngineStats;
+
+static long long nowMs(void) {
+#ifdef _WIN32
+    return (long long)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+// 한 판 진행: 반환값은 승자 색 (무승부 EMPTY)
+static int playGame(int gameIndex, int mctsColor, EngineStats stats[2]) {
+    int board[BOARD_SIZE][BOARD_SIZE];
+    int toMove = BLACK;
+    int center = BOARD_SIZE / 2;
+
+    memset(board, 0, sizeof(board));
+    mctsReset();
+
+    // 개국: 흑 중앙 + 백 인접 8칸 중 하나 (색을 바꾼 두 판은 같은 개국)
+    static const int OPEN_DR[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+    static const int OPEN_DC[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    int opening = (gameIndex / 2) % 8;
+    board[center][center] = BLACK;
+    board[center + OPEN_DR[opening]][center + OPEN_DC[opening]] = WHITE;
+
+    for (int ply = 2; ply < BOARD_SIZE * BOARD_SIZE; ply++) {
+        int useMcts = (toMove == mctsColor);
+        EngineStats *st = &stats[useMcts];
+
+        setSearchEngine(useMcts ? ENGINE_MCTS : ENGINE_ALPHABETA);
+        long long start = nowMs();
+        Move move = findBestMove(board, toMove, HARD);
+        st->totalMs += nowMs() - start;
+        st->totalNodes += getLastSearchNodes();
+        long long probes, hits;
+        getEvalCacheStats(&probes, &hits);
+        st->evalProbes += probes;
+        st->evalHits += hits;
+        st->moves++;
+
+        if (move.row < 0 || move.row >= BOARD_SIZE || move.col < 0 || move.col >= BOARD_SIZE ||
+            board[move.row][move.col] != EMPTY) {
+            printf("  [오류] %s 엔진이 잘못된 수 (%d, %d)\n", st->name, move.row, move.col);
+            return (toMove == BLACK) ? WHITE : BLACK;
+        }
+
+        board[move.row][move.col] = toMove;
+        if (checkWinBoard(board, move.row, move.col, toMove)) {
+            return toMove;
+        }
+        toMove = (toMove == BLACK) ? WHITE : BLACK;
+    }
+
+    return EMPTY;
+}
+
+int main(int argc, char *argv[]) {
+    int games = (argc > 1) ? atoi(argv[1]) : 4;
+    int timeMs = (argc > 2) ? atoi(argv[2]) : 1000;
+    int threads = (argc > 3) ? atoi(argv[3]) : 0;
+    int draws = 0;
+    EngineStats stats[2] = {
+        {"Alpha-Beta", 0, 0, 0, 0, 0, 0},
+        {"MCTS", 0, 0, 0, 0, 0, 0}
+    };
+
+    if (games <= 0) games = 4;
+    if (timeMs <= 0) timeMs = 1000;
+
+    initAI();
+    setSearchTimeBudget(timeMs);
+    setTurnTime(timeMs);
+    mctsSetThreads(threads);
+
+    printf("자가 대국: %d판, 시계 %dms/수\n\n", games, timeMs);
+
+    for (int g = 0; g < games; g++) {
+        // 흑/백을 번갈아 맡음
+        int mctsColor = (g % 2 == 0) ? BLACK : WHITE;
+        int winner = playGame(g, mctsColor, stats);
+
+        if (winner == EMPTY) {
+            draws++;
+            printf("대국 %2d: 무승부\n", g + 1);
+        } else {
+            EngineStats *st = &stats[winner == mctsColor];
+            st->wins++;
+            printf("대국 %2d: %s 승 (%s)\n", g + 1, st->name, (winner == BLACK) ? "흑" : "백");
+        }
+        fflush(stdout);
+    }
+
+    printf("\n%-12s %6s %8s %12s %14s %12s\n", "엔진", "승", "착수", "평균(ms)", "노드/초", "평가캐시(%)");
+    for (int i = 0; i < 2; i++) {
+        EngineStats *st = &stats[i];
+        double avgMs = st->moves ? (double)st->totalMs / st->moves : 0.0;
+        double nps = st->totalMs ? (double)st->totalNodes * 1000.0 / st->totalMs : 0.0;
+        double hitRate = st->evalProbes ? 100.0 * st->evalHits / st->evalProbes : 0.0;
+        printf("%-12s %6d %8d %12.1f %14.0f %12.1f\n", st->name, st->wins, st->moves, avgMs, nps, hitRate);
+    }
+    printf("무승부: %d\n", draws);
+
+    cleanupAI();
+    return 0;
+}
@@ -27,6 +27,7 @@
 static ClientInfo clients[MAX_CLIENTS];
 static GameRoom rooms[MAX_ROOMS];
 static int nextRoomId = 1;
+static int renjuRules = 0;      /* --renju: 흑 쌍삼/쌍사/장목 금지 */
 
 /* 함수 프로토타입 */
 void initServer(void);
@@ -35,9 +36,9 @@ void handleClientMessage(int clientIndex);
 void handleDisconnect(int clientIndex);
 
 /* 방 관련 함수 */
-int createRoom(int clientIndex, const char* roomName);
+int createRoom(int clientIndex, const char* roomName, int boardSize);
 void sendRoomList(int clientIndex);
-int joinRoom(int clientIndex, int roomId);
+int joinRoom(int clientIndex, int roomId, int boardSize);
 void leaveRoom(int clientIndex);
 void startGame(int roomIndex);
 
@@ -46,6 +47,7 @@ void handleMove(int clientIndex, NetMessage* msg);
 void endGame(int roomIndex, int winner);
 
 /* 유틸리티 */
+void resetRoomBoard(int roomIndex);
 int findEmptyClientSlot(void);
 int findEmptyRoomSlot(void);
 int findRoomById(int roomId);
@@ -63,11 +65,15 @@ int main(int argc, char* argv[]) {
     int i;
     int activity;
 
-    /* 포트 인자 처리 */
-    if (argc > 1) {
-        port = atoi(argv[1]);
-        if (port <= 0 || port > 65535) {
-            port = SERVER_PORT;
+    /* 인자 처리: [포트] [--renju] */
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--renju") == 0) {
+            renjuRules = FORBID_RENJU;
+        } else {
+            port = atoi(argv[i]);
+            if (port <= 0 || port > 65535) {
+                port = SERVER_PORT;
+            }
         }
     }
 
@@ -93,6 +99,9 @@ int main(int argc, char* argv[]) {
     }
 
     printf("서버 시작 (포트: %d)\n", port);
+    if (renjuRules) {
+        printf("렌주 규칙: 흑 금수 적용\n");
+    }
     printf("클라이언트 연결 대기 중...\n\n");
 
     /* 메인 루프 */
@@ -160,7 +169,7 @@ int main(int argc, char* argv[]) {
 /* ========== 서버 초기화 ========== */
 
 void initServer(void) {
-    int i, j;
+    int i;
 
     for (i = 0; i < MAX_CLIENTS; i++) {
         clients[i].socket = INVALID_SOCK;
@@ -181,10 +190,20 @@ void initServer(void) {
         rooms[i].inGame = 0;
         rooms[i].currentTurn = 1;
         rooms[i].moveCount = 0;
-        for (j = 0; j < BOARD_NET_SIZE; j++) {
-            memset(rooms[i].board[j], 0, sizeof(int) * BOARD_NET_SIZE);
-        }
+        rooms[i].boardSize = BOARD_NET_SIZE;
+        resetRoomBoard(i);
+    }
+}
+
+/* 방 크기에 맞는 커널로 보드 초기화 (렌주 금수는 15x15 방만) */
+void resetRoomBoard(int roomIndex) {
+    if (rooms[roomIndex].boardSize == 19) {
+        mbInit19(rooms[roomIndex].board);
+    } else {
+        mbInit15(rooms[roomIndex].board);
     }
+    forbidInit(&rooms[roomIndex].forbid, 1,
+               rooms[roomIndex].boardSize == 15 ? renjuRules : 0);
 }
 
 int findEmptyClientSlot(void) {
@@ -279,19 +298,21 @@ void handleClientMessage(int clientIndex) {
             /* 닉네임 저장 */
             strncpy(clients[clientIndex].nickname, msg.nickname,
                     sizeof(clients[clientIndex].nickname) - 1);
-            printf("[접속] 클라이언트 #%d: %s\n",
-                   clientIndex, clients[clientIndex].nickname);
+            /* msg.x = 클라이언트 프로토콜 버전 (0 = 버전 1, 방 크기를 보내지 않으므로 15x15로만 둠) */
+            printf("[접속] 클라이언트 #%d: %s (프로토콜 v%d)\n",
+                   clientIndex, clients[clientIndex].nickname, msg.x > 0 ? msg.x : 1);
 
-            /* 접속 확인 응답 */
+            /* 접속 확인 응답 (x = 서버 프로토콜 버전) */
             memset(&response, 0, sizeof(response));
             response.type = MSG_CONNECT_ACK;
+            response.x = NET_PROTOCOL_VERSION;
             strcpy(response.message, "서버 접속 성공! 방을 만들거나 입장하세요.");
             net_send_message(clients[clientIndex].socket, &response);
             break;
 
         case MSG_ROOM_CREATE:
-            /* 방 생성 */
-            if (createRoom(clientIndex, msg.nickname) >= 0) {
+            /* 방 생성 (msg.y = 보드 크기, 0이면 15) */
+            if (createRoom(clientIndex, msg.nickname, msg.y) >= 0) {
                 printf("[방 생성] %s님이 '%s' 방 생성\n",
                        clients[clientIndex].nickname, msg.nickname);
             }
@@ -303,8 +324,8 @@ void handleClientMessage(int clientIndex) {
             break;
 
         case MSG_ROOM_JOIN:
-            /* 방 입장 (msg.x = roomId) */
-            roomIndex = joinRoom(clientIndex, msg.x);
+            /* 방 입장 (msg.x = roomId, msg.y = 클라이언트 보드 크기) */
+            roomIndex = joinRoom(clientIndex, msg.x, msg.y);
             if (roomIndex >= 0) {
                 printf("[방 입장] %s님이 방 #%d 입장\n",
                        clients[clientIndex].nickname, msg.x);
@@ -391,10 +412,21 @@ void handleDisconnect(int clientIndex) {
 
 /* ========== 방 관련 함수 ========== */
 
-int createRoom(int clientIndex, const char* roomName) {
+int createRoom(int clientIndex, const char* roomName, int boardSize) {
     int roomIndex;
     NetMessage response;
 
+    if (boardSize == 0) {
+        boardSize = BOARD_NET_SIZE;
+    }
+    if (boardSize != 15 && boardSize != 19) {
+        memset(&response, 0, sizeof(response));
+        response.type = MSG_ERROR;
+        strcpy(response.message, "보드 크기는 15 또는 19만 가능합니다.");
+        net_send_message(clients[clientIndex].socket, &response);
+        return -1;
+    }
+
     roomIndex = findEmptyRoomSlot();
     if (roomIndex < 0) {
         memset(&response, 0, sizeof(response));
@@ -413,7 +445,8 @@ int createRoom(int clientIndex, const char* roomName) {
     rooms[roomIndex].inGame = 0;
     rooms[roomIndex].currentTurn = 1;
     rooms[roomIndex].moveCount = 0;
-    memset(rooms[roomIndex].board, 0, sizeof(rooms[roomIndex].board));
+    rooms[roomIndex].boardSize = boardSize;
+    resetRoomBoard(roomIndex);
 
     /* 클라이언트 상태 업데이트 */
     clients[clientIndex].inRoom = 1;
@@ -423,7 +456,9 @@ int createRoom(int clientIndex, const char* roomName) {
     memset(&response, 0, sizeof(response));
     response.type = MSG_ROOM_CREATE_ACK;
     response.x = rooms[roomIndex].roomId;
-    sprintf(response.message, "방 '%s' 생성 완료! 상대방을 기다리는 중...", roomName);
+    response.y = boardSize;
+    sprintf(response.message, "방 '%s' (%dx%d) 생성 완료! 상대방을 기다리는 중...",
+            roomName, boardSize, boardSize);
     net_send_message(clients[clientIndex].socket, &response);
 
     printStatus();
@@ -451,6 +486,10 @@ void sendRoomList(int clientIndex) {
                 response.rooms[count].playerCount = 2;
             }
             response.rooms[count].inGame = rooms[i].inGame;
+            /* 방 크기는 RoomInfo에 없음 (구조체 크기 유지): 19x19 방은 result의 비트로 */
+            if (rooms[i].boardSize == 19) {
+                response.result |= 1 << count;
+            }
 
             count++;
         }
@@ -463,7 +502,7 @@ void sendRoomList(int clientIndex) {
            clients[clientIndex].nickname, count);
 }
 
-int joinRoom(int clientIndex, int roomId) {
+int joinRoom(int clientIndex, int roomId, int boardSize) {
     int roomIndex;
     NetMessage response;
     NetMessage startMsg;
@@ -496,6 +535,19 @@ int joinRoom(int clientIndex, int roomId) {
         return -1;
     }
 
+    /* 보드 크기 확인 (15x15 클라이언트가 19x19 방에 들어가지 않도록) */
+    if (boardSize == 0) {
+        boardSize = BOARD_NET_SIZE;
+    }
+    if (boardSize != rooms[roomIndex].boardSize) {
+        memset(&response, 0, sizeof(response));
+        response.type = MSG_ERROR;
+        sprintf(response.message, "%dx%d 방입니다. 보드 크기가 맞지 않습니다.",
+                rooms[roomIndex].boardSize, rooms[roomIndex].boardSize);
+        net_send_message(clients[clientIndex].socket, &response);
+        return -1;
+    }
+
     /* 입장 처리 */
     rooms[roomIndex].guestIndex = clientIndex;
     clients[clientIndex].inRoom = 1;
@@ -564,14 +616,9 @@ void startGame(int roomIndex) {
     NetMessage msg1, msg2;
     int hostIndex = rooms[roomIndex].hostIndex;
     int guestIndex = rooms[roomIndex].guestIndex;
-    int i, j;
 
     /* 보드 초기화 */
-    for (i = 0; i < BOARD_NET_SIZE; i++) {
-        for (j = 0; j < BOARD_NET_SIZE; j++) {
-            rooms[roomIndex].board[i][j] = 0;
-        }
-    }
+    resetRoomBoard(roomIndex);
     rooms[roomIndex].currentTurn = 1;
     rooms[roomIndex].moveCount = 0;
     rooms[roomIndex].inGame = 1;
@@ -588,6 +635,7 @@ void startGame(int roomIndex) {
     /* 게임 시작 메시지 전송 */
     net_create_game_start_msg(&msg1, 1, clients[guestIndex].nickname);
     net_create_game_start_msg(&msg2, 2, clients[hostIndex].nickname);
+    msg1.x = msg2.x = rooms[roomIndex].boardSize;
 
     net_send_message(clients[hostIndex].socket, &msg1);
     net_send_message(clients[guestIndex].socket, &msg2);
@@ -605,6 +653,8 @@ void handleMove(int clientIndex, NetMessage* msg) {
     int x, y;
     int playerColor;
     int opponentIndex;
+    int size;
+    int idx;
     NetMessage response;
     NetMessage moveMsg;
 
@@ -617,6 +667,7 @@ void handleMove(int clientIndex, NetMessage* msg) {
     opponentIndex = clients[clientIndex].opponentIndex;
     x = msg->x;
     y = msg->y;
+    size = rooms[roomIndex].boardSize;
 
     /* 턴 확인 */
     if (rooms[roomIndex].currentTurn != playerColor) {
@@ -628,7 +679,7 @@ void handleMove(int clientIndex, NetMessage* msg) {
     }
 
     /* 유효성 검사 */
-    if (x < 0 || x >= BOARD_NET_SIZE || y < 0 || y >= BOARD_NET_SIZE) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
         memset(&response, 0, sizeof(response));
         response.type = MSG_ERROR;
         strcpy(response.message, "잘못된 좌표입니다.");
@@ -636,7 +687,8 @@ void handleMove(int clientIndex, NetMessage* msg) {
         return;
     }
 
-    if (rooms[roomIndex].board[y][x] != 0) {
+    idx = MB_INDEX_N(size, y, x);
+    if (rooms[roomIndex].board[idx] != 0) {
         memset(&response, 0, sizeof(response));
         response.type = MSG_ERROR;
         strcpy(response.message, "이미 돌이 있는 위치입니다.");
@@ -644,8 +696,20 @@ void handleMove(int clientIndex, NetMessage* msg) {
         return;
     }
 
+    /* 렌주 규칙: 흑 금수 자리 (15x15 방만) */
+    if (size == 15 && playerColor == 1 && forbidTest(&rooms[roomIndex].forbid, y, x)) {
+        memset(&response, 0, sizeof(response));
+        response.type = MSG_ERROR;
+        strcpy(response.message, "금수 자리입니다. (쌍삼/쌍사/장목)");
+        net_send_message(clients[clientIndex].socket, &response);
+        return;
+    }
+
     /* 착수 */
-    rooms[roomIndex].board[y][x] = playerColor;
+    rooms[roomIndex].board[idx] = (unsigned char)playerColor;
+    if (size == 15) {
+        forbidUpdate(&rooms[roomIndex].forbid, rooms[roomIndex].board, idx);
+    }
     rooms[roomIndex].moveCount++;
 
     printf("[착수] 방 #%d: %s (%d, %d)\n",
@@ -664,7 +728,7 @@ void handleMove(int clientIndex, NetMessage* msg) {
     net_send_message(clients[opponentIndex].socket, &moveMsg);
 
     /* 승리 체크 */
-    if (net_check_win(rooms[roomIndex].board, x, y, playerColor)) {
+    if (net_check_win(rooms[roomIndex].board, size, x, y, playerColor)) {
         printf("[게임 종료] 방 #%d: %s 승리!\n",
                rooms[roomIndex].roomId, clients[clientIndex].nickname);
         endGame(roomIndex, playerColor);
@@ -672,7 +736,7 @@ void handleMove(int clientIndex, NetMessage* msg) {
     }
 
     /* 무승부 체크 */
-    if (rooms[roomIndex].moveCount >= BOARD_NET_SIZE * BOARD_NET_SIZE) {
+    if (rooms[roomIndex].moveCount >= size * size) {
         printf("[게임 종료] 방 #%d: 무승부\n", rooms[roomIndex].roomId);
         endGame(roomIndex, 0);
         return;
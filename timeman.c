@@ -0,0 +1,98 @@
+// 탐색 시간 관리 (엔진, 클라이언트 공용)
+
+#include "timeman.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+// 단조 증가 시계 (ms)
+long long tmNowMs(void) {
+#ifdef _WIN32
+    return (long long)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+void tmStart(TimeManager *tm, int turnMs, int moveNumber, int threats) {
+    int safety = (turnMs / 10 < TM_SAFETY_MS) ? turnMs / 10 : TM_SAFETY_MS;
+    int usable = turnMs - safety;
+    int percent;
+
+    // 진행 단계별 기본 비율: 초반은 짧게, 중반에 가장 많이
+    if (moveNumber < 4) percent = 10;
+    else if (moveNumber < 40) percent = 30;
+    else percent = 20;
+
+    // 위협이 많을수록 복잡한 국면 (위협 하나당 +25%, 최대 두 배)
+    if (threats > 4) threats = 4;
+    percent += percent * threats / 4;
+
+    tm->start = tmNowMs();
+    tm->softMs = usable * percent / 100;
+    tm->hardMs = (tm->softMs * 5 < usable) ? tm->softMs * 5 : usable;
+    if (tm->hardMs < 1) tm->hardMs = 1;
+    tm->lastBest = -1;
+    tm->instability = 0;
+    tm->lastIterMs = 0;
+    tm->branching = 16;     // 처음엔 깊이 하나당 4배로 가정
+    tm->stopped = 0;
+}
+
+int tmElapsed(const TimeManager *tm) {
+    return (int)(tmNowMs() - tm->start);
+}
+
+int tmHardExpired(TimeManager *tm) {
+    if (!tm->stopped && tmElapsed(tm) >= tm->hardMs) {
+        tm->stopped = 1;
+    }
+    return tm->stopped;
+}
+
+// 흔들림만큼 늘린 소프트 한계 (최대 하드 한계)
+static int adjustedSoft(const TimeManager *tm) {
+    int soft = tm->softMs + tm->softMs * tm->instability / 4;
+    return (soft < tm->hardMs) ? soft : tm->hardMs;
+}
+
+int tmSoftRemaining(const TimeManager *tm) {
+    int remain = adjustedSoft(tm) - tmElapsed(tm);
+    return (remain > 0) ? remain : 0;
+}
+
+int tmNextIteration(TimeManager *tm, int bestMove, int iterMs) {
+    // 최선 수가 바뀌면 불안정 (감쇠 누적)
+    tm->instability /= 2;
+    if (tm->lastBest >= 0 && bestMove != tm->lastBest) {
+        tm->instability += 4;
+    }
+    tm->lastBest = bestMove;
+
+    // 반복 간 시간 증가율 갱신 (2배 ~ 8배)
+    if (tm->lastIterMs > 0 && iterMs > 0) {
+        int ratio = iterMs * 4 / tm->lastIterMs;
+        if (ratio < 8) ratio = 8;
+        if (ratio > 32) ratio = 32;
+        tm->branching = ratio;
+    }
+    tm->lastIterMs = iterMs;
+
+    int elapsed = tmElapsed(tm);
+    int predicted = iterMs * tm->branching / 4;
+
+    // 소프트 한계 안이고, 다음 반복이 하드 한계 전에 끝날 것 같을 때만 계속
+    return elapsed < adjustedSoft(tm) && elapsed + predicted <= tm->hardMs;
+}
+
+int tmNodesAllowNext(long long used, long long iterNodes, long long *lastIterNodes, long long limit) {
+    long long predicted = (*lastIterNodes > 0) ? iterNodes * iterNodes / *lastIterNodes : iterNodes * 4;
+    if (predicted < iterNodes * 2) predicted = iterNodes * 2;
+    *lastIterNodes = iterNodes;
+    return limit <= 0 || used + predicted <= limit;
+}
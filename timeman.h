@@ -0,0 +1,39 @@
+// 탐색 시간 관리 헤더 (한 수당 소프트/하드 데드라인)
+//
+// 소프트 데드라인: 새 반복(깊이)을 시작해도 되는 한계. 진행 단계, 위협 수로 정하고
+//                  반복 사이 최선 수가 흔들리면 늘린다.
+// 하드 데드라인:   탐색을 무조건 끊는 시각. 턴 제한에서 여유분을 뺀 값을 넘지 않는다.
+
+#ifndef TIMEMAN_H
+#define TIMEMAN_H
+
+#define TM_SAFETY_MS 300        // 출력/네트워크 여유 (턴의 10%를 넘지 않음)
+
+typedef struct {
+    long long start;
+    int softMs;             // 기본 소프트 한계 (시작 기준)
+    int hardMs;             // 하드 한계 (시작 기준)
+    int lastBest;           // 직전 반복의 최선 수 (-1 = 없음)
+    int instability;        // 최선 수 변경 누적 (1/4 단위, 반복마다 절반 감쇠)
+    int lastIterMs;         // 직전 반복 소요 시간
+    int branching;          // 반복 간 시간 증가율 추정 (x4 단위)
+    int stopped;            // 하드 데드라인 도달
+} TimeManager;
+
+long long tmNowMs(void);
+
+// turnMs: 이번 수에 쓸 수 있는 시계, moveNumber: 보드 위 돌 수, threats: 위협 수
+void tmStart(TimeManager *tm, int turnMs, int moveNumber, int threats);
+
+int tmElapsed(const TimeManager *tm);
+int tmHardExpired(TimeManager *tm);         // 하드 데드라인이 지났으면 1 (stopped 설정)
+int tmSoftRemaining(const TimeManager *tm); // 소프트 한계까지 남은 ms (MCTS 예산 등)
+
+// 반복 하나가 끝났을 때 호출. 다음 깊이를 시작해도 되면 1
+int tmNextIteration(TimeManager *tm, int bestMove, int iterMs);
+
+// 노드 예산: 반복 하나가 iterNodes개로 끝나 누적 used개일 때 다음 반복도 limit 안에 끝날 것 같으면 1
+// (*lastIterNodes는 직전 반복 노드 수, 호출마다 갱신. 증가율은 최소 2배로 가정, limit 0 = 제한 없음)
+int tmNodesAllowNext(long long used, long long iterNodes, long long *lastIterNodes, long long limit);
+
+#endif
@@ -0,0 +1,78 @@
+// 탐색 트레이스 기록 (버퍼에 모아 한 번에 쓰기)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+#include "mailbox.h"
+
+#define TRACE_BUFFER 65536      // 레코드 수 (1.3MB)
+
+_Thread_local int traceOn = 0;
+
+static FILE *traceFile = NULL;
+static TraceRecord *buffer = NULL;
+static int buffered = 0;
+static int exitHooked = 0;
+static long long written = 0;
+
+static void flushBuffer(void) {
+    if (traceFile != NULL && buffered > 0) {
+        fwrite(buffer, sizeof(TraceRecord), buffered, traceFile);
+        written += buffered;
+    }
+    buffered = 0;
+}
+
+static void closeAtExit(void) {
+    traceClose();
+}
+
+int traceOpen(const char *path) {
+    TraceHeader header;
+
+    traceClose();
+    buffer = (TraceRecord*)malloc(TRACE_BUFFER * sizeof(TraceRecord));
+    if (buffer == NULL) return 0;
+
+    traceFile = fopen(path, "wb");
+    if (traceFile == NULL) {
+        free(buffer);
+        buffer = NULL;
+        return 0;
+    }
+
+    memcpy(header.magic, TRACE_MAGIC, 4);
+    header.version = TRACE_VERSION;
+    header.recordSize = (unsigned short)sizeof(TraceRecord);
+    header.boardSize = MB_BOARD_SIZE;
+    header.reserved = 0;
+    fwrite(&header, sizeof(header), 1, traceFile);
+
+    buffered = 0;
+    written = 0;
+    traceOn = 1;
+    if (!exitHooked) {
+        atexit(closeAtExit);
+        exitHooked = 1;
+    }
+    return 1;
+}
+
+void traceClose(void) {
+    if (traceFile == NULL) return;
+
+    flushBuffer();
+    fclose(traceFile);
+    fprintf(stderr, "탐색 트레이스: 노드 %lld개 기록\n", written);
+    traceFile = NULL;
+    free(buffer);
+    buffer = NULL;
+    traceOn = 0;
+}
+
+void traceWrite(const TraceRecord *record) {
+    if (buffer == NULL) return;
+    buffer[buffered++] = *record;
+    if (buffered == TRACE_BUFFER) flushBuffer();
+}
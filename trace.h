@@ -0,0 +1,54 @@
+// 탐색 트레이스 헤더 (오프라인 트리 분석용 이진 기록)
+//
+// OMOK_TRACE=파일 로 실행하면 initAI를 부른 스레드의 탐색 노드를 전부 기록한다.
+// 노드를 나갈 때 20바이트 레코드 하나를 쓰므로 파일은 후위 순서(자식이 부모보다 먼저)이고,
+// ply만으로 트리를 복원할 수 있다 (tracedump.c). 레코드는 메모리 버퍼에 모았다가
+// 가득 차면 한 번에 쓴다. 꺼져 있으면 노드마다 스레드 로컬 플래그 확인 한 번이 전부다.
+//
+// 파일: TraceHeader 다음에 TraceRecord 배열 (리틀 엔디언, 기록한 기기 그대로)
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#define TRACE_MAGIC "OMTR"
+#define TRACE_VERSION 2
+
+// 노드 종류 (flags의 하위 3비트)
+#define TRACE_KIND_MASK 7
+#define TRACE_MARK 0            // 탐색 시작 표시 (move = 둘 차례 색, 나머지 0)
+#define TRACE_MINIMAX 1         // 쉬움/보통/분석 탐색 노드
+#define TRACE_HARD 2            // 어려움 모드 탐색 노드
+#define TRACE_QUIESCE 3         // 위협 정지 탐색 노드
+#define TRACE_ROOT 4            // 다중 PV 분석의 루트 (후보 하나를 뺀 루트 탐색)
+
+#define TRACE_MAXIMIZING 0x08   // AI 차례 노드
+#define TRACE_ABORTED 0x10      // 노드 예산/데드라인으로 중단됨
+
+typedef struct {
+    char magic[4];
+    unsigned short version;
+    unsigned short recordSize;
+    unsigned short boardSize;   // 기록한 엔진의 보드 크기 (수 번호 = row * boardSize + col)
+    unsigned short reserved;
+} TraceHeader;
+
+typedef struct {
+    int alpha;              // 진입 시 창
+    int beta;
+    int score;              // 반환 점수 (AI 관점)
+    short move;             // 이 노드로 온 수 (row * boardSize + col, -1 = 루트)
+    short best;             // 이 노드가 고른 수 (-1 = 없음)
+    unsigned char ply;      // 루트 0
+    signed char depth;      // 남은 깊이 (정지 탐색은 -정지 탐색 ply)
+    signed char cutoff;     // 컷(또는 즉시 승리)이 난 후보 순번 (-1 = 모든 후보 탐색)
+    unsigned char flags;    // TRACE_KIND_MASK | TRACE_MAXIMIZING | TRACE_ABORTED
+} TraceRecord;
+
+// 이 스레드의 기록 시작 (성공 1). 다른 스레드의 탐색은 기록하지 않는다
+int traceOpen(const char *path);
+void traceClose(void);                  // 버퍼를 쓰고 파일을 닫음 (종료 시 자동)
+void traceWrite(const TraceRecord *record);
+
+extern _Thread_local int traceOn;       // 이 스레드가 기록 중이면 1
+
+#endif
@@ -0,0 +1,286 @@
+// 탐색 트레이스 뷰어/내보내기 (OMOK_TRACE로 기록한 파일, trace.h)
+// 레코드는 노드를 나갈 때 쓰인 후위 순서이므로, ply가 p인 레코드를 읽으면 스택 위의
+// ply p+1 레코드들이 그 자식이다. 이렇게 트리를 복원한 뒤 MARK로 탐색을 나누고,
+// ply 0 노드 하나를 반복 심화의 반복 하나로 본다.
+//
+// 사용법: ./omok_tracedump [-s 탐색 번호] [-i 반복 번호] [-t 출력 깊이] [-csv] 파일.trc
+//   기본: 탐색마다 반복 요약(깊이, 점수, 최선 수, PV) + 마지막 반복의 ply별 표
+//   -t N: 선택한 반복의 트리를 ply N까지 출력
+//   -csv: 모든 노드를 부모 번호와 함께 CSV로 출력 (다른 도구로 분석)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+#define MAX_PLY 256
+#define MAX_PV 64
+#define MOVE_TEXT 24            // "행,열" 문자열 버퍼
+
+static int boardSize = 15;      // 트레이스 헤더의 보드 크기
+static TraceRecord *records = NULL;
+static int recordCount = 0;
+static int *parent = NULL;
+static int *firstChild = NULL;
+static int *nextSibling = NULL;
+
+static const char *kindName[] = {"mark", "minimax", "hard", "quiesce", "root", "?", "?", "?"};
+
+static int kindOf(const TraceRecord *r) {
+    return r->flags & TRACE_KIND_MASK;
+}
+
+static void moveText(int move, char *out) {
+    if (move < 0) strcpy(out, "-");
+    else sprintf(out, "%d,%d", move / boardSize, move % boardSize);
+}
+
+static int loadTrace(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    TraceHeader header;
+    int capacity = 1 << 16;
+
+    if (fp == NULL) {
+        fprintf(stderr, "파일을 열 수 없습니다: %s\n", path);
+        return 0;
+    }
+    if (fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, TRACE_MAGIC, 4) != 0 ||
+        header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord) ||
+        header.boardSize == 0) {
+        fprintf(stderr, "트레이스 파일 형식이 아닙니다: %s\n", path);
+        fclose(fp);
+        return 0;
+    }
+    boardSize = header.boardSize;
+
+    records = (TraceRecord*)malloc(capacity * sizeof(TraceRecord));
+    while (records != NULL) {
+        size_t got = fread(records + recordCount, sizeof(TraceRecord), capacity - recordCount, fp);
+        recordCount += (int)got;
+        if (recordCount < capacity) break;
+        capacity *= 2;
+        records = (TraceRecord*)realloc(records, capacity * sizeof(TraceRecord));
+    }
+    fclose(fp);
+    if (records == NULL) {
+        fprintf(stderr, "메모리가 부족합니다\n");
+        return 0;
+    }
+    return 1;
+}
+
+// 후위 순서 + ply로 부모/자식 연결 (MARK는 스택을 비움)
+static void buildTree(void) {
+    int *stack = (int*)malloc((recordCount + 1) * sizeof(int));
+    int top = 0;
+
+    parent = (int*)malloc(recordCount * sizeof(int));
+    firstChild = (int*)malloc(recordCount * sizeof(int));
+    nextSibling = (int*)malloc(recordCount * sizeof(int));
+
+    for (int i = 0; i < recordCount; i++) {
+        parent[i] = firstChild[i] = nextSibling[i] = -1;
+        if (kindOf(&records[i]) == TRACE_MARK) {
+            top = 0;
+            continue;
+        }
+
+        // 스택 위에서 ply+1인 연속 구간이 자식 (원래 순서대로 연결)
+        int ply = records[i].ply;
+        int base = top;
+        while (base > 0 && records[stack[base - 1]].ply == ply + 1) base--;
+        for (int j = top - 1; j >= base; j--) {
+            int child = stack[j];
+            parent[child] = i;
+            nextSibling[child] = firstChild[i];
+            firstChild[i] = child;
+        }
+        top = base;
+        stack[top++] = i;
+    }
+    free(stack);
+}
+
+// 최선 수를 따라 내려간 PV (정지 탐색에 들어가면 끝)
+static int collectPv(int node, int pv[]) {
+    int length = 0;
+
+    while (node >= 0 && records[node].best >= 0 && length < MAX_PV) {
+        int next = -1;
+        pv[length++] = records[node].best;
+        for (int c = firstChild[node]; c >= 0; c = nextSibling[c]) {
+            if (records[c].move == records[node].best) next = c;
+        }
+        node = next;
+    }
+    return length;
+}
+
+// ply별 통계 (본 탐색 / 정지 탐색 분리)
+typedef struct {
+    long long nodes;
+    long long interior;     // 자식이 있는 본 탐색 노드
+    long long quiesce;
+    long long cutoffs;
+    long long firstCutoffs;
+} PlyStats;
+
+static void collectStats(int node, PlyStats stats[], int *maxPly) {
+    int ply = records[node].ply;
+
+    if (ply >= MAX_PLY) return;
+    if (ply > *maxPly) *maxPly = ply;
+    if (kindOf(&records[node]) == TRACE_QUIESCE) {
+        stats[ply].quiesce++;
+    } else {
+        stats[ply].nodes++;
+        if (firstChild[node] >= 0) stats[ply].interior++;
+        if (records[node].cutoff >= 0) {
+            stats[ply].cutoffs++;
+            if (records[node].cutoff == 0) stats[ply].firstCutoffs++;
+        }
+    }
+    for (int c = firstChild[node]; c >= 0; c = nextSibling[c]) {
+        collectStats(c, stats, maxPly);
+    }
+}
+
+static void printPlyTable(int root) {
+    PlyStats stats[MAX_PLY];
+    int maxPly = 0;
+
+    memset(stats, 0, sizeof(stats));
+    collectStats(root, stats, &maxPly);
+
+    printf("  ply      노드   정지탐색      컷  첫수컷%%     EBF\n");
+    for (int p = 0; p <= maxPly; p++) {
+        char ebf[16] = "-";
+        char first[16] = "-";
+        if (p < maxPly && stats[p].interior > 0 && stats[p + 1].nodes > 0) {
+            sprintf(ebf, "%.2f", (double)stats[p + 1].nodes / stats[p].interior);
+        }
+        if (stats[p].cutoffs > 0) {
+            sprintf(first, "%.1f", 100.0 * stats[p].firstCutoffs / stats[p].cutoffs);
+        }
+        printf("  %3d %9lld %10lld %7lld %8s %7s\n",
+               p, stats[p].nodes, stats[p].quiesce, stats[p].cutoffs, first, ebf);
+    }
+}
+
+static void printTree(int node, int maxPly) {
+    const TraceRecord *r = &records[node];
+    char move[MOVE_TEXT], best[MOVE_TEXT];
+
+    moveText(r->move, move);
+    moveText(r->best, best);
+    printf("%*s%s %s d=%d [%d, %d] -> %d best=%s cut=%d%s%s\n",
+           r->ply * 2, "", move, kindName[kindOf(r)], r->depth, r->alpha, r->beta, r->score, best,
+           r->cutoff, (r->flags & TRACE_MAXIMIZING) ? " max" : " min",
+           (r->flags & TRACE_ABORTED) ? " 중단" : "");
+    if (r->ply >= maxPly) return;
+    for (int c = firstChild[node]; c >= 0; c = nextSibling[c]) {
+        printTree(c, maxPly);
+    }
+}
+
+static void exportCsv(void) {
+    printf("index,parent,kind,ply,move,depth,alpha,beta,score,best,cutoff,maximizing,aborted\n");
+    for (int i = 0; i < recordCount; i++) {
+        const TraceRecord *r = &records[i];
+        printf("%d,%d,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\n",
+               i, parent[i], kindName[kindOf(r)], r->ply, r->move, r->depth, r->alpha, r->beta,
+               r->score, r->best, r->cutoff, (r->flags & TRACE_MAXIMIZING) != 0,
+               (r->flags & TRACE_ABORTED) != 0);
+    }
+}
+
+static void usage(void) {
+    fprintf(stderr, "사용법: ./omok_tracedump [-s 탐색 번호] [-i 반복 번호] [-t 출력 깊이] [-csv] 파일.trc\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    int searchSel = -1;
+    int iterSel = -1;
+    int treeDepth = -1;
+    int csv = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            searchSel = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            iterSel = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            treeDepth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-csv") == 0) {
+            csv = 1;
+        } else if (argv[i][0] == '-' || path != NULL) {
+            usage();
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL) {
+        usage();
+        return 1;
+    }
+    if (!loadTrace(path)) return 1;
+    buildTree();
+
+    if (csv) {
+        exportCsv();
+        return 0;
+    }
+
+    // 탐색 단위로 훑기: MARK 다음 ply 0 노드들이 반복
+    int search = -1;
+    int i = 0;
+    while (i < recordCount) {
+        int color = 0;
+        if (kindOf(&records[i]) == TRACE_MARK) {
+            color = records[i].move;
+            i++;
+        }
+        search++;
+
+        int start = i;
+        while (i < recordCount && kindOf(&records[i]) != TRACE_MARK) i++;
+        if (searchSel >= 0 ? search != searchSel : i == start) continue;   // 기본은 빈 탐색(즉답) 생략
+
+        int iterations[MAX_PLY];
+        int iterCount = 0;
+        for (int j = start; j < i; j++) {
+            if (records[j].ply == 0 && iterCount < MAX_PLY) iterations[iterCount++] = j;
+        }
+        printf("탐색 #%d (%s 차례, 노드 %d개, 반복 %d번)\n",
+               search, (color == 1) ? "흑" : (color == 2) ? "백" : "?", i - start, iterCount);
+
+        for (int k = 0; k < iterCount; k++) {
+            const TraceRecord *r = &records[iterations[k]];
+            int pv[MAX_PV];
+            int pvLength = collectPv(iterations[k], pv);
+            char text[MOVE_TEXT];
+
+            printf("  [%d] %s 깊이 %d 점수 %d%s PV", k, kindName[kindOf(r)], r->depth, r->score,
+                   (r->flags & TRACE_ABORTED) ? " (중단)" : "");
+            for (int m = 0; m < pvLength; m++) {
+                moveText(pv[m], text);
+                printf(" %s", text);
+            }
+            printf("\n");
+        }
+        if (iterCount == 0) continue;
+
+        int pick = (iterSel >= 0 && iterSel < iterCount) ? iterSel : iterCount - 1;
+        printf(" 반복 [%d] ply별:\n", pick);
+        printPlyTable(iterations[pick]);
+        if (treeDepth >= 0) printTree(iterations[pick], treeDepth);
+    }
+
+    free(records);
+    free(parent);
+    free(firstChild);
+    free(nextSibling);
+    return 0;
+}
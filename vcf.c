@@ -0,0 +1,181 @@
+// 연속 4 승리(VCF) 탐색기 (어려움 모드 포트폴리오 탐색의 위협 전용 스레드)
+
+#include "vcf.h"
+#include "mailbox.h"
+#include "forbid.h"
+
+typedef struct {
+    int rules;
+    long long nodes;
+    long long nodeCap;
+    atomic_int *stop;
+    int aborted;
+    int line[VCF_MAX_LINE];     // 메일박스 인덱스
+    int length;
+} VcfSolver;
+
+static int otherColor(int color) {
+    return (color == BLACK) ? WHITE : BLACK;
+}
+
+static int isForbidden(const unsigned char *mb, int idx, int color, int rules) {
+    return rules && color == BLACK && forbidCheckCell(mb, idx, BLACK, rules);
+}
+
+// 빈칸 cell에 color를 두면 dir 방향으로 5목이 되는지 (렌주 흑은 정확히 5목만)
+static int fiveAt(const unsigned char *mb, int cell, int dir, int color, int rules) {
+    int count = 1;
+    int p = cell + dir;
+    while (mb[p] == color) {
+        count++;
+        p += dir;
+    }
+    p = cell - dir;
+    while (mb[p] == color) {
+        count++;
+        p -= dir;
+    }
+    if (count == 5) return 1;
+    return count > 5 && !(color == BLACK && (rules & FORBID_OVERLINE));
+}
+
+static int addCell(int cells[2], int count, int cell) {
+    if (count > 0 && cells[0] == cell) return count;
+    if (count < 2) cells[count] = cell;
+    return count + 1;
+}
+
+// idx에 둔 color 돌로 새로 생긴 5목 자리 (둘까지 채우고 개수는 2에서 멈춤)
+static int fiveCellsAfter(const unsigned char *mb, int idx, int color, int rules, int cells[2]) {
+    int count = 0;
+
+    for (int dir = 0; dir < 4 && count < 2; dir++) {
+        int d = MB_DIR[dir];
+        for (int side = -1; side <= 1; side += 2) {
+            int p = idx;
+            for (int step = 1; step <= 4; step++) {
+                p += side * d;
+                if (mb[p] == MB_WALL || mb[p] == otherColor(color)) break;
+                if (mb[p] == EMPTY && fiveAt(mb, p, d, color, rules)) {
+                    count = addCell(cells, count, p);
+                    if (count >= 2) return 2;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// 보드 전체에서 color의 5목 자리
+static int scanFives(const unsigned char *mb, int color, int rules, int cells[2]) {
+    int count = 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (mb[idx] != EMPTY) continue;
+            for (int dir = 0; dir < 4; dir++) {
+                if (fiveAt(mb, idx, MB_DIR[dir], color, rules)) {
+                    count = addCell(cells, count, idx);
+                    break;
+                }
+            }
+            if (count >= 2) return 2;
+        }
+    }
+    return count;
+}
+
+// color 차례. mustBlock >= 0이면 수비의 5목 자리라 공격은 거기에 4목을 만들어야 함
+static int attack(VcfSolver *s, unsigned char *mb, int color, int foursLeft, int mustBlock, int ply) {
+    int defender = otherColor(color);
+
+    s->nodes++;
+    if (s->nodes > s->nodeCap ||
+        ((s->nodes & 63) == 0 && s->stop != NULL && atomic_load_explicit(s->stop, memory_order_relaxed))) {
+        s->aborted = 1;
+    }
+    if (s->aborted || foursLeft == 0 || ply + 2 > VCF_MAX_LINE) return 0;
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        int idx = MB_INDEX(row, 0);
+        for (int col = 0; col < BOARD_SIZE; col++, idx++) {
+            if (mb[idx] != EMPTY) continue;
+            if (mustBlock >= 0 && idx != mustBlock) continue;
+            if (isForbidden(mb, idx, color, s->rules)) continue;
+
+            int cells[2];
+            mb[idx] = (unsigned char)color;
+            int fives = fiveCellsAfter(mb, idx, color, s->rules, cells);
+            int win = 0;
+
+            if (fives >= 2 || (fives == 1 && isForbidden(mb, cells[0], defender, s->rules))) {
+                // 4-4(또는 열린 4), 막을 자리가 금수: 수비가 못 막음
+                s->line[ply] = idx;
+                s->length = ply + 1;
+                win = 1;
+            } else if (fives == 1) {
+                // 수비는 5목 자리를 막을 수밖에 없음. 막으면서 5목 자리를 둘 만들면 이 줄은 실패
+                int block = cells[0];
+                int threats[2];
+                mb[block] = (unsigned char)defender;
+                int counter = fiveCellsAfter(mb, block, defender, s->rules, threats);
+                if (counter < 2 &&
+                    attack(s, mb, color, foursLeft - 1, counter ? threats[0] : -1, ply + 2)) {
+                    s->line[ply] = idx;
+                    s->line[ply + 1] = block;
+                    win = 1;
+                }
+                mb[block] = EMPTY;
+            }
+
+            mb[idx] = EMPTY;
+            if (win) return 1;
+            if (s->aborted) return 0;
+        }
+    }
+    return 0;
+}
+
+int vcfSolve(unsigned char *mb, int color, int rules, int maxFours, long long nodeCap,
+             atomic_int *stop, VcfResult *result) {
+    int own[2], theirs[2];
+    VcfSolver s;
+
+    result->length = 0;
+    result->nodes = 0;
+
+    // 이미 5목 자리가 있으면 그 수로 끝
+    if (scanFives(mb, color, rules, own) > 0) {
+        result->line[0].row = MB_ROW(own[0]);
+        result->line[0].col = MB_COL(own[0]);
+        result->length = 1;
+        return 1;
+    }
+
+    // 상대 5목 자리가 둘이면 4목으로 밀어도 소용없음, 하나면 거기부터 막아야 함
+    int threats = scanFives(mb, otherColor(color), rules, theirs);
+    if (threats >= 2) return 0;
+
+    s.rules = rules;
+    s.nodes = 0;
+    s.nodeCap = nodeCap;
+    s.stop = stop;
+    s.aborted = 0;
+    s.length = 0;
+
+    // 짧은 승리부터 (공격 수 한계를 늘려 가며)
+    int found = 0;
+    for (int fours = 1; fours <= maxFours && !found && !s.aborted; fours++) {
+        found = attack(&s, mb, color, fours, threats ? theirs[0] : -1, 0);
+    }
+
+    result->nodes = s.nodes;
+    if (!found) return 0;
+    for (int i = 0; i < s.length; i++) {
+        result->line[i].row = MB_ROW(s.line[i]);
+        result->line[i].col = MB_COL(s.line[i]);
+    }
+    result->length = s.length;
+    return 1;
+}
@@ -0,0 +1,28 @@
+// 연속 4 승리(VCF) 탐색기 헤더
+//
+// 공격 쪽이 4목(다음 수에 5목 자리가 생기는 수)만 계속 두어 이기는 길이 있는지 찾는다.
+// 수비는 매번 그 5목 자리를 막는 수 하나뿐이라 분기가 작아 깊게 볼 수 있다.
+// 5목 판정은 떨어진 4(XX_XX)까지 라인 위 칸을 직접 세고, 렌주 규칙이면 흑의 금수 4와
+// 흑이 막을 자리가 금수인 경우도 따진다. 넘겨받은 보드 위에서만 두고 무르므로
+// 보드 사본을 주면 다른 탐색 스레드와 동시에 돌려도 된다.
+
+#ifndef VCF_H
+#define VCF_H
+
+#include <stdatomic.h>
+#include "minimax.h"
+
+#define VCF_MAX_LINE 64
+
+typedef struct {
+    Move line[VCF_MAX_LINE];    // 공격/수비 교대 진행 (line[0]이 첫 공격 수)
+    int length;
+    long long nodes;
+} VcfResult;
+
+// color가 먼저 두어 4목만으로 이기면 1 (maxFours: 공격 수 한계, rules: FORBID_* 조합)
+// nodeCap을 넘거나 stop이 켜지면 0 (stop은 NULL 가능). mb는 메일박스, 끝나면 원래대로
+int vcfSolve(unsigned char *mb, int color, int rules, int maxFours, long long nodeCap,
+             atomic_int *stop, VcfResult *result);
+
+#endif